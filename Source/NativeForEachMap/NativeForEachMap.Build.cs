@@ -20,7 +20,9 @@ public class NativeForEachMap : ModuleRules
 			"Slate", 
 			"SlateCore", 
 			"KismetCompiler", 
-			"UnrealEd"
+			"Json", 
+			"UnrealEd", 
+			"NativeForEachMapRuntime"
 		});
 	}
 }
@@ -0,0 +1,36 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ForEachLoopTypes.generated.h"
+
+/** How a loop node runs through its container */
+UENUM()
+enum class EForEachLoopMode : uint8
+{
+	/** Runs through the whole container right away */
+	Immediate,
+
+	/** Spreads the loop across frames, waits for the next one whenever the per-frame budget is used up. Event graphs only */
+	TimeSliced UMETA(DisplayName = "Time Sliced"),
+
+	/** Only moves on once Continue fires, so the loop body may Delay or wait on async work in between. Event graphs only */
+	Awaitable,
+};
+
+/** Which order a loop node walks its container in */
+UENUM()
+enum class EForEachOrder : uint8
+{
+	/** Storage order, costs nothing on loop entry */
+	Unordered,
+
+	/** Sorted by key (or element, for sets) */
+	KeyAscending UMETA(DisplayName = "By Key, Ascending"),
+	KeyDescending UMETA(DisplayName = "By Key, Descending"),
+
+	/** Sorted by value, maps only */
+	ValueAscending UMETA(DisplayName = "By Value, Ascending"),
+	ValueDescending UMETA(DisplayName = "By Value, Descending"),
+};
@@ -0,0 +1,455 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "ForEachMapBenchmarkCommandlet.h"
+
+#include "Dom/JsonObject.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "ForEachMapBenchmarkGraphs.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/Package.h"
+
+#include <atomic>
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ForEachMapBenchmarkCommandlet)
+
+namespace ForEachMapBenchmark_Private
+{
+	using namespace ForEachMapBenchmarkGraphs;
+
+	/** Every measurement visits at least this many entries in total, small containers are simply run more often */
+	static constexpr int32 TargetVisits = 2000000;
+	static constexpr int32 MinRepeats = 5;
+
+	/**
+	 * Forwards everything to the real allocator and counts what the game thread allocates while enabled.
+	 * Stays alive for the rest of the process once installed, other threads may still be in the middle of a call.
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner)
+			: Inner(InInner)
+		{
+		}
+
+		void Install() { GMalloc = this; }
+		void Uninstall() { GMalloc = Inner; }
+
+		void Start()
+		{
+			Allocations = 0;
+			bCounting.store(true, std::memory_order_relaxed);
+		}
+
+		int64 Stop()
+		{
+			bCounting.store(false, std::memory_order_relaxed);
+			return Allocations;
+		}
+
+		//~ Begin FMalloc Interface
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override { Tally(); return Inner->Malloc(Size, Alignment); }
+		virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override { Tally(); return Inner->TryMalloc(Size, Alignment); }
+		virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override { if (Size > 0) { Tally(); } return Inner->Realloc(Original, Size, Alignment); }
+		virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override { if (Size > 0) { Tally(); } return Inner->TryRealloc(Original, Size, Alignment); }
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+		//~ End FMalloc Interface
+
+	private:
+		void Tally()
+		{
+			if (bCounting.load(std::memory_order_relaxed) && IsInGameThread())
+			{
+				++Allocations;
+			}
+		}
+
+		FMalloc* Inner;
+		std::atomic<bool> bCounting { false };
+		int64 Allocations = 0;
+	};
+
+	/** Name, pin type, a way to make the Nth distinct value and a cheap read of a value for every type we benchmark */
+	template <typename T>
+	struct TBenchmarkType;
+
+	template <>
+	struct TBenchmarkType<int32>
+	{
+		static const TCHAR* GetName() { return TEXT("int"); }
+		static int32 Make(int32 Index) { return Index; }
+		static uint32 Touch(int32 Value) { return static_cast<uint32>(Value); }
+
+		static FEdGraphPinType GetPinType()
+		{
+			FEdGraphPinType PinType;
+			PinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+			return PinType;
+		}
+	};
+
+	template <>
+	struct TBenchmarkType<FName>
+	{
+		static const TCHAR* GetName() { return TEXT("name"); }
+		static FName Make(int32 Index) { return FName(TEXT("Entry"), Index); }
+		static uint32 Touch(const FName& Value) { return GetTypeHash(Value); }
+
+		static FEdGraphPinType GetPinType()
+		{
+			FEdGraphPinType PinType;
+			PinType.PinCategory = UEdGraphSchema_K2::PC_Name;
+			return PinType;
+		}
+	};
+
+	/** Stands in for the large structs, it's bigger than a cache line and every loop has to copy it around */
+	template <>
+	struct TBenchmarkType<FTransform>
+	{
+		static const TCHAR* GetName() { return TEXT("transform"); }
+		static FTransform Make(int32 Index) { return FTransform(FVector(Index)); }
+		static uint32 Touch(const FTransform& Value) { return static_cast<uint32>(Value.GetTranslation().X); }
+
+		static FEdGraphPinType GetPinType()
+		{
+			FEdGraphPinType PinType;
+			PinType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+			PinType.PinSubCategoryObject = TBaseStructure<FTransform>::Get();
+			return PinType;
+		}
+	};
+
+	/** The native loops we hold the nodes against, they read every key and value just like the benchmark Blueprints do */
+	template <typename KeyType, typename ValueType>
+	FORCENOINLINE uint32 NativeLoop(const TMap<KeyType, ValueType>& Map)
+	{
+		uint32 Checksum = 0;
+		for (const TPair<KeyType, ValueType>& Pair : Map)
+		{
+			Checksum += TBenchmarkType<KeyType>::Touch(Pair.Key) ^ TBenchmarkType<ValueType>::Touch(Pair.Value);
+		}
+		return Checksum;
+	}
+
+	template <typename ElementType>
+	FORCENOINLINE uint32 NativeLoop(const TSet<ElementType>& Set)
+	{
+		uint32 Checksum = 0;
+		for (const ElementType& Element : Set)
+		{
+			Checksum += TBenchmarkType<ElementType>::Touch(Element);
+		}
+		return Checksum;
+	}
+
+	template <typename ElementType>
+	FORCENOINLINE uint32 NativeLoop(const TArray<ElementType>& Array)
+	{
+		uint32 Checksum = 0;
+		for (const ElementType& Element : Array)
+		{
+			Checksum += TBenchmarkType<ElementType>::Touch(Element);
+		}
+		return Checksum;
+	}
+
+	struct FBenchmarkRow
+	{
+		FString Node;
+		FString KeyType;
+		FString ValueType;
+		int32 Size = 0;
+		int32 Repeats = 0;
+		double BlueprintNsPerIteration = 0.0;
+		double NativeNsPerIteration = 0.0;
+		double AllocationsPerRun = 0.0;
+	};
+
+	struct FBenchmarkContext
+	{
+		FCountingMalloc* Counter = nullptr;
+		TArray<int32> Sizes;
+		TArray<FBenchmarkRow> Rows;
+		int32 NumFailed = 0;
+	};
+
+	/** Runs the Blueprint over the given container and the native loop over the very same one */
+	template <typename ContainerType>
+	FBenchmarkRow Measure(FBenchmarkContext& Context, UBlueprint* Blueprint, const ContainerType& Native, int32 Size)
+	{
+		UObject* Instance = NewObject<UObject>(GetTransientPackage(), Blueprint->GeneratedClass);
+		UFunction* Function = Instance->FindFunctionChecked(LoopFunctionName);
+
+		// The script containers share their layout with the native ones, so the property can copy straight from it
+		const FProperty* Property = FindFProperty<FProperty>(Instance->GetClass(), ContainerVarName);
+		check(Property);
+		Property->CopyCompleteValue(Property->ContainerPtrToValuePtr<void>(Instance), &Native);
+
+		FBenchmarkRow Row;
+		Row.Size = Size;
+		Row.Repeats = FMath::Max(MinRepeats, TargetVisits / Size);
+
+		// Warm both up first, the first run pays for the frame and any lazily created caches
+		Instance->ProcessEvent(Function, nullptr);
+		uint32 Checksum = NativeLoop(Native);
+
+		Context.Counter->Start();
+		const uint64 BlueprintStart = FPlatformTime::Cycles64();
+		for (int32 Run = 0; Run < Row.Repeats; ++Run)
+		{
+			Instance->ProcessEvent(Function, nullptr);
+		}
+		const uint64 BlueprintCycles = FPlatformTime::Cycles64() - BlueprintStart;
+		const int64 Allocations = Context.Counter->Stop();
+
+		const uint64 NativeStart = FPlatformTime::Cycles64();
+		for (int32 Run = 0; Run < Row.Repeats; ++Run)
+		{
+			Checksum += NativeLoop(Native);
+		}
+		const uint64 NativeCycles = FPlatformTime::Cycles64() - NativeStart;
+
+		const double Visits = static_cast<double>(Row.Repeats) * Size;
+		Row.BlueprintNsPerIteration = FPlatformTime::ToSeconds64(BlueprintCycles) * 1e9 / Visits;
+		Row.NativeNsPerIteration = FPlatformTime::ToSeconds64(NativeCycles) * 1e9 / Visits;
+		Row.AllocationsPerRun = static_cast<double>(Allocations) / Row.Repeats;
+
+		// Keeps the native loops from being optimized away
+		UE_LOG(LogForEachMapBenchmark, Verbose, TEXT("Native checksum %u"), Checksum);
+
+		Instance->MarkAsGarbage();
+		return Row;
+	}
+
+	void AddRow(FBenchmarkContext& Context, FBenchmarkRow&& Row)
+	{
+		UE_LOG(LogForEachMapBenchmark, Display, TEXT("%-18s %-9s %-9s %8d  %9.2f ns  (native %7.2f ns)  %7.2f allocs/run"),
+			*Row.Node, *Row.KeyType, *Row.ValueType, Row.Size,
+			Row.BlueprintNsPerIteration, Row.NativeNsPerIteration, Row.AllocationsPerRun);
+
+		Context.Rows.Add(MoveTemp(Row));
+	}
+
+	/** Builds and compiles the Blueprint a case runs, a single loop over the container */
+	UBlueprint* MakeCaseBlueprint(FBenchmarkContext& Context, const FLoopNodeSetup& Setup, const FString& Name)
+	{
+		UBlueprint* Blueprint = BuildLoopBlueprint(Setup, Name);
+		if (!CompileLoopBlueprint(Blueprint))
+		{
+			++Context.NumFailed;
+			return nullptr;
+		}
+
+		return Blueprint;
+	}
+
+	template <typename KeyType, typename ValueType>
+	void RunMapCase(FBenchmarkContext& Context)
+	{
+		using FKey = TBenchmarkType<KeyType>;
+		using FValue = TBenchmarkType<ValueType>;
+
+		const FLoopNodeSetup Setup = MakeMapLoop(FKey::GetPinType(), FValue::GetPinType());
+		UBlueprint* Blueprint = MakeCaseBlueprint(Context, Setup, FString::Printf(TEXT("BP_ForEachMap_%s_%s"), FKey::GetName(), FValue::GetName()));
+		if (Blueprint == nullptr)
+		{
+			return;
+		}
+
+		for (const int32 Size : Context.Sizes)
+		{
+			TMap<KeyType, ValueType> Native;
+			Native.Reserve(Size);
+			for (int32 Index = 0; Index < Size; ++Index)
+			{
+				Native.Add(FKey::Make(Index), FValue::Make(Index));
+			}
+
+			FBenchmarkRow Row = Measure(Context, Blueprint, Native, Size);
+			Row.Node = Setup.NodeName;
+			Row.KeyType = FKey::GetName();
+			Row.ValueType = FValue::GetName();
+			AddRow(Context, MoveTemp(Row));
+		}
+	}
+
+	template <typename ElementType>
+	void RunSetCase(FBenchmarkContext& Context)
+	{
+		using FElement = TBenchmarkType<ElementType>;
+
+		const FLoopNodeSetup Setup = MakeSetLoop(FElement::GetPinType());
+		UBlueprint* Blueprint = MakeCaseBlueprint(Context, Setup, FString::Printf(TEXT("BP_ForEachSet_%s"), FElement::GetName()));
+		if (Blueprint == nullptr)
+		{
+			return;
+		}
+
+		for (const int32 Size : Context.Sizes)
+		{
+			TSet<ElementType> Native;
+			Native.Reserve(Size);
+			for (int32 Index = 0; Index < Size; ++Index)
+			{
+				Native.Add(FElement::Make(Index));
+			}
+
+			FBenchmarkRow Row = Measure(Context, Blueprint, Native, Size);
+			Row.Node = Setup.NodeName;
+			Row.KeyType = FElement::GetName();
+			AddRow(Context, MoveTemp(Row));
+		}
+	}
+
+	template <typename ElementType>
+	void RunArrayCase(FBenchmarkContext& Context)
+	{
+		using FElement = TBenchmarkType<ElementType>;
+
+		const FLoopNodeSetup Setup = MakeArrayLoop(FElement::GetPinType());
+		UBlueprint* Blueprint = MakeCaseBlueprint(Context, Setup, FString::Printf(TEXT("BP_InternalIterate_%s"), FElement::GetName()));
+		if (Blueprint == nullptr)
+		{
+			return;
+		}
+
+		for (const int32 Size : Context.Sizes)
+		{
+			TArray<ElementType> Native;
+			Native.Reserve(Size);
+			for (int32 Index = 0; Index < Size; ++Index)
+			{
+				Native.Add(FElement::Make(Index));
+			}
+
+			FBenchmarkRow Row = Measure(Context, Blueprint, Native, Size);
+			Row.Node = Setup.NodeName;
+			Row.KeyType = FElement::GetName();
+			AddRow(Context, MoveTemp(Row));
+		}
+	}
+
+	FString WriteCsv(const TArray<FBenchmarkRow>& Rows)
+	{
+		FString Csv = TEXT("Node,KeyType,ValueType,Size,Repeats,BlueprintNsPerIteration,NativeNsPerIteration,AllocationsPerRun\n");
+		for (const FBenchmarkRow& Row : Rows)
+		{
+			Csv += FString::Printf(TEXT("%s,%s,%s,%d,%d,%.3f,%.3f,%.3f\n"),
+				*Row.Node, *Row.KeyType, *Row.ValueType, Row.Size, Row.Repeats,
+				Row.BlueprintNsPerIteration, Row.NativeNsPerIteration, Row.AllocationsPerRun);
+		}
+		return Csv;
+	}
+
+	FString WriteJson(const TArray<FBenchmarkRow>& Rows)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		for (const FBenchmarkRow& Row : Rows)
+		{
+			TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->SetStringField(TEXT("node"), Row.Node);
+			Object->SetStringField(TEXT("keyType"), Row.KeyType);
+			Object->SetStringField(TEXT("valueType"), Row.ValueType);
+			Object->SetNumberField(TEXT("size"), Row.Size);
+			Object->SetNumberField(TEXT("repeats"), Row.Repeats);
+			Object->SetNumberField(TEXT("blueprintNsPerIteration"), Row.BlueprintNsPerIteration);
+			Object->SetNumberField(TEXT("nativeNsPerIteration"), Row.NativeNsPerIteration);
+			Object->SetNumberField(TEXT("allocationsPerRun"), Row.AllocationsPerRun);
+			Values.Add(MakeShared<FJsonValueObject>(Object));
+		}
+
+		FString Json;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Values, Writer);
+		return Json;
+	}
+}
+
+UForEachMapBenchmarkCommandlet::UForEachMapBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UForEachMapBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace ForEachMapBenchmark_Private;
+
+	FBenchmarkContext Context;
+
+	FString SizesParam = TEXT("10,100,1000,10000,100000,1000000");
+	FParse::Value(*Params, TEXT("Sizes="), SizesParam, /*bShouldStopOnSeparator=*/ false);
+
+	TArray<FString> SizeStrings;
+	SizesParam.ParseIntoArray(SizeStrings, TEXT(","));
+	for (const FString& SizeString : SizeStrings)
+	{
+		const int32 Size = FCString::Atoi(*SizeString);
+		if (Size < 1)
+		{
+			UE_LOG(LogForEachMapBenchmark, Error, TEXT("Invalid container size '%s'"), *SizeString);
+			return 1;
+		}
+		Context.Sizes.Add(Size);
+	}
+
+	FString NodesParam = TEXT("Map,Set,Array");
+	FParse::Value(*Params, TEXT("Nodes="), NodesParam, /*bShouldStopOnSeparator=*/ false);
+
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("ForEachMapBenchmark.csv");
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	// Counting only starts around the timed Blueprint runs, the counter costs one branch per allocation otherwise
+	static FCountingMalloc Counter(GMalloc);
+	Context.Counter = &Counter;
+	Counter.Install();
+
+	if (NodesParam.Contains(TEXT("Map")))
+	{
+		RunMapCase<int32, int32>(Context);
+		RunMapCase<FName, int32>(Context);
+		RunMapCase<int32, FTransform>(Context);
+	}
+
+	if (NodesParam.Contains(TEXT("Set")))
+	{
+		RunSetCase<int32>(Context);
+		RunSetCase<FName>(Context);
+	}
+
+	if (NodesParam.Contains(TEXT("Array")))
+	{
+		RunArrayCase<int32>(Context);
+		RunArrayCase<FName>(Context);
+		RunArrayCase<FTransform>(Context);
+	}
+
+	Counter.Uninstall();
+
+	const bool bJson = FPaths::GetExtension(OutputPath).Equals(TEXT("json"), ESearchCase::IgnoreCase);
+	const FString Output = bJson ? WriteJson(Context.Rows) : WriteCsv(Context.Rows);
+	if (!FFileHelper::SaveStringToFile(Output, *OutputPath))
+	{
+		UE_LOG(LogForEachMapBenchmark, Error, TEXT("Failed to write the results to %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogForEachMapBenchmark, Display, TEXT("Wrote %d result(s) to %s"), Context.Rows.Num(), *OutputPath);
+	return Context.NumFailed > 0 ? 1 : 0;
+}
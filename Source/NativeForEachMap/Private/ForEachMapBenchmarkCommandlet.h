@@ -0,0 +1,26 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ForEachMapBenchmarkCommandlet.generated.h"
+
+/**
+ * Measures what the loop nodes cost per iteration. Compiles a throwaway Blueprint per node and key/value type,
+ * runs it over containers of growing size and compares it against the same loop written natively.
+ *
+ * UnrealEditor-Cmd <Project> -run=ForEachMapBenchmark -nullrhi [-Sizes=10,1000,...] [-Nodes=Map,Set,Array] [-Output=<File>.csv|.json]
+ */
+UCLASS()
+class UForEachMapBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UForEachMapBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -0,0 +1,175 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "ForEachMapBenchmarkGraphs.h"
+
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "K2Node_ForEachMap.h"
+#include "K2Node_ForEachSet.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_InternalIterate.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY(LogForEachMapBenchmark);
+
+namespace ForEachMapBenchmarkGraphs
+{
+	const FName ContainerVarName(TEXT("Container"));
+	const FName LoopFunctionName(TEXT("RunLoop"));
+
+	static const FName KeySinkVarName(TEXT("KeySink"));
+	static const FName ValueSinkVarName(TEXT("ValueSink"));
+
+	template <typename NodeType>
+	static NodeType* SpawnNode(UEdGraph& Graph)
+	{
+		FGraphNodeCreator<NodeType> Creator(Graph);
+		NodeType* Node = Creator.CreateNode();
+		Creator.Finalize();
+		return Node;
+	}
+
+	template <typename NodeType>
+	static NodeType* SpawnVariableNode(UEdGraph& Graph, const FName VariableName)
+	{
+		FGraphNodeCreator<NodeType> Creator(Graph);
+		NodeType* Node = Creator.CreateNode();
+		Node->VariableReference.SetSelfMember(VariableName);
+		Creator.Finalize();
+		return Node;
+	}
+
+	FLoopNodeSetup MakeMapLoop(const FEdGraphPinType& KeyType, const FEdGraphPinType& ValueType)
+	{
+		FLoopNodeSetup Setup;
+		Setup.NodeName = TEXT("For Each Map");
+		Setup.KeyType = KeyType;
+		Setup.ValueType = ValueType;
+		Setup.ContainerType = KeyType;
+		Setup.ContainerType.ContainerType = EPinContainerType::Map;
+		Setup.ContainerType.PinValueType = FEdGraphTerminalType::FromPinType(ValueType);
+		Setup.SpawnLoopNode = [](UEdGraph& Graph, FLoopPins& OutPins) -> UK2Node*
+		{
+			UK2Node_ForEachMap* Node = SpawnNode<UK2Node_ForEachMap>(Graph);
+			OutPins.Container = Node->GetInputMapPin();
+			OutPins.Body = Node->GetLoopBodyPin();
+			OutPins.Key = Node->GetKeyPin();
+			OutPins.Value = Node->GetValuePin();
+			OutPins.Completed = Node->GetCompletePin();
+			return Node;
+		};
+		return Setup;
+	}
+
+	FLoopNodeSetup MakeSetLoop(const FEdGraphPinType& ElementType)
+	{
+		FLoopNodeSetup Setup;
+		Setup.NodeName = TEXT("For Each Set");
+		Setup.KeyType = ElementType;
+		Setup.ContainerType = ElementType;
+		Setup.ContainerType.ContainerType = EPinContainerType::Set;
+		Setup.SpawnLoopNode = [](UEdGraph& Graph, FLoopPins& OutPins) -> UK2Node*
+		{
+			UK2Node_ForEachSet* Node = SpawnNode<UK2Node_ForEachSet>(Graph);
+			OutPins.Container = Node->GetInputSetPin();
+			OutPins.Body = Node->GetLoopBodyPin();
+			OutPins.Key = Node->GetValuePin();
+			OutPins.Completed = Node->GetCompletePin();
+			return Node;
+		};
+		return Setup;
+	}
+
+	FLoopNodeSetup MakeArrayLoop(const FEdGraphPinType& ElementType)
+	{
+		FLoopNodeSetup Setup;
+		Setup.NodeName = TEXT("Internal Iterate");
+		Setup.KeyType = ElementType;
+		Setup.ContainerType = ElementType;
+		Setup.ContainerType.ContainerType = EPinContainerType::Array;
+		Setup.SpawnLoopNode = [](UEdGraph& Graph, FLoopPins& OutPins) -> UK2Node*
+		{
+			UK2Node_InternalIterate* Node = SpawnNode<UK2Node_InternalIterate>(Graph);
+			OutPins.Container = Node->GetArrayPin();
+			OutPins.Body = Node->GetForEachPin();
+			OutPins.Key = Node->GetElementPin();
+			OutPins.Completed = Node->GetCompletedPin();
+			return Node;
+		};
+		return Setup;
+	}
+
+	UBlueprint* BuildLoopBlueprint(const FLoopNodeSetup& Setup, const FString& Name, int32 NumLoops)
+	{
+		UPackage* Package = GetTransientPackage();
+		UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(
+			UObject::StaticClass(),
+			Package,
+			MakeUniqueObjectName(Package, UBlueprint::StaticClass(), FName(Name)),
+			BPTYPE_Normal,
+			UBlueprint::StaticClass(),
+			UBlueprintGeneratedClass::StaticClass());
+
+		FBlueprintEditorUtils::AddMemberVariable(Blueprint, ContainerVarName, Setup.ContainerType);
+		FBlueprintEditorUtils::AddMemberVariable(Blueprint, KeySinkVarName, Setup.KeyType);
+		if (Setup.ValueType.IsSet())
+		{
+			FBlueprintEditorUtils::AddMemberVariable(Blueprint, ValueSinkVarName, Setup.ValueType.GetValue());
+		}
+
+		UEdGraph* Graph = FBlueprintEditorUtils::CreateNewGraph(Blueprint, LoopFunctionName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+		FBlueprintEditorUtils::AddFunctionGraph<UClass>(Blueprint, Graph, /*bIsUserCreated=*/ true, nullptr);
+
+		const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+		TArray<UK2Node_FunctionEntry*> EntryNodes;
+		Graph->GetNodesOfClass(EntryNodes);
+		check(EntryNodes.Num() == 1);
+
+		// Each loop starts once the previous one completed
+		UEdGraphPin* PreviousThen = EntryNodes[0]->GetThenPin();
+		for (int32 LoopIndex = 0; LoopIndex < NumLoops; ++LoopIndex)
+		{
+			FLoopPins Pins;
+			UK2Node* LoopNode = Setup.SpawnLoopNode(*Graph, Pins);
+
+			UK2Node_VariableGet* GetContainer = SpawnVariableNode<UK2Node_VariableGet>(*Graph, ContainerVarName);
+			Schema->TryCreateConnection(PreviousThen, LoopNode->GetExecPin());
+			Schema->TryCreateConnection(GetContainer->GetValuePin(), Pins.Container);
+
+			UK2Node_VariableSet* SetKey = SpawnVariableNode<UK2Node_VariableSet>(*Graph, KeySinkVarName);
+			Schema->TryCreateConnection(Pins.Body, SetKey->GetExecPin());
+			Schema->TryCreateConnection(Pins.Key, SetKey->FindPinChecked(KeySinkVarName));
+
+			if (Pins.Value != nullptr)
+			{
+				UK2Node_VariableSet* SetValue = SpawnVariableNode<UK2Node_VariableSet>(*Graph, ValueSinkVarName);
+				Schema->TryCreateConnection(SetKey->GetThenPin(), SetValue->GetExecPin());
+				Schema->TryCreateConnection(Pins.Value, SetValue->FindPinChecked(ValueSinkVarName));
+			}
+
+			PreviousThen = Pins.Completed;
+		}
+
+		return Blueprint;
+	}
+
+	bool CompileLoopBlueprint(UBlueprint* Blueprint, EBlueprintCompileOptions CompileOptions)
+	{
+		FCompilerResultsLog Results;
+		FKismetEditorUtilities::CompileBlueprint(Blueprint, CompileOptions, &Results);
+		if (Blueprint->Status == BS_Error)
+		{
+			UE_LOG(LogForEachMapBenchmark, Error, TEXT("%s failed to compile with %d error(s)"), *Blueprint->GetName(), Results.NumErrors);
+			return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,57 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Kismet2/KismetEditorUtilities.h"
+
+class UBlueprint;
+class UEdGraph;
+class UK2Node;
+
+/** Shared by the benchmark commandlets and the graph builder, all of them live in this module */
+DECLARE_LOG_CATEGORY_EXTERN(LogForEachMapBenchmark, Log, All);
+
+/** Builds the throwaway Blueprints the benchmark commandlets compile and run */
+namespace ForEachMapBenchmarkGraphs
+{
+	/** Member variable the loops walk, and the function holding them */
+	extern const FName ContainerVarName;
+	extern const FName LoopFunctionName;
+
+	/** The pins of a loop node the graph builder wires up, the value pin only exists for maps */
+	struct FLoopPins
+	{
+		UEdGraphPin* Container = nullptr;
+		UEdGraphPin* Body = nullptr;
+		UEdGraphPin* Key = nullptr;
+		UEdGraphPin* Value = nullptr;
+		UEdGraphPin* Completed = nullptr;
+	};
+
+	/** Which loop node to place and what it runs over. The value type is only set for maps */
+	struct FLoopNodeSetup
+	{
+		FString NodeName;
+		FEdGraphPinType ContainerType;
+		FEdGraphPinType KeyType;
+		TOptional<FEdGraphPinType> ValueType;
+
+		/** Spawns the loop node into the graph */
+		TFunction<UK2Node*(UEdGraph& Graph, FLoopPins& OutPins)> SpawnLoopNode;
+	};
+
+	FLoopNodeSetup MakeMapLoop(const FEdGraphPinType& KeyType, const FEdGraphPinType& ValueType);
+	FLoopNodeSetup MakeSetLoop(const FEdGraphPinType& ElementType);
+	FLoopNodeSetup MakeArrayLoop(const FEdGraphPinType& ElementType);
+
+	/**
+	 * Creates a transient Blueprint whose RunLoop function runs the given number of loop nodes back to back over its Container variable.
+	 * Every loop body copies the key (or element) and the value into member variables, so nothing gets pruned.
+	 */
+	UBlueprint* BuildLoopBlueprint(const FLoopNodeSetup& Setup, const FString& Name, int32 NumLoops = 1);
+
+	/** Compiles the Blueprint, returns false and logs if it came out with errors */
+	bool CompileLoopBlueprint(UBlueprint* Blueprint, EBlueprintCompileOptions CompileOptions = EBlueprintCompileOptions::SkipGarbageCollection);
+}
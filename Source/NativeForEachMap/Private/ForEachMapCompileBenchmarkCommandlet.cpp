@@ -0,0 +1,319 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "ForEachMapCompileBenchmarkCommandlet.h"
+
+#include "Dom/JsonObject.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "ForEachMapBenchmarkGraphs.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ForEachMapCompileBenchmarkCommandlet)
+
+DEFINE_LOG_CATEGORY_STATIC(LogForEachMapCompileBenchmark, Log, All);
+
+namespace ForEachMapCompileBenchmark_Private
+{
+	using namespace ForEachMapBenchmarkGraphs;
+
+	struct FCompileRow
+	{
+		FString Node;
+		int32 NumLoops = 0;
+		double CompileMs = 0.0;
+		double CompileMsPerLoop = 0.0;
+		int32 IntermediateNodes = 0;
+		double IntermediateNodesPerLoop = 0.0;
+	};
+
+	struct FCompileMeasurement
+	{
+		double CompileMs = 0.0;
+		int32 IntermediateNodes = 0;
+	};
+
+	/**
+	 * Compiles a Blueprint with the given number of loops a few times and keeps the fastest run, the slower ones mostly measure
+	 * the editor doing something else. One more compile keeps the expanded graphs around to count what is left of them.
+	 */
+	bool Measure(const FLoopNodeSetup& Setup, int32 NumLoops, int32 Repeats, FCompileMeasurement& OutMeasurement)
+	{
+		UBlueprint* Blueprint = BuildLoopBlueprint(Setup, FString::Printf(TEXT("BP_CompileBenchmark_%d"), NumLoops), NumLoops);
+
+		OutMeasurement.CompileMs = TNumericLimits<double>::Max();
+		for (int32 Run = 0; Run < Repeats; ++Run)
+		{
+			const double Start = FPlatformTime::Seconds();
+			if (!CompileLoopBlueprint(Blueprint))
+			{
+				return false;
+			}
+			OutMeasurement.CompileMs = FMath::Min(OutMeasurement.CompileMs, (FPlatformTime::Seconds() - Start) * 1000.0);
+		}
+
+		Blueprint->IntermediateGeneratedGraphs.Empty();
+		if (!CompileLoopBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection | EBlueprintCompileOptions::SaveIntermediateProducts))
+		{
+			return false;
+		}
+
+		OutMeasurement.IntermediateNodes = 0;
+		for (const UEdGraph* Graph : Blueprint->IntermediateGeneratedGraphs)
+		{
+			if (Graph != nullptr)
+			{
+				OutMeasurement.IntermediateNodes += Graph->Nodes.Num();
+			}
+		}
+
+		return true;
+	}
+
+	/** Measures every loop count for one node, the per loop figures are relative to the same Blueprint without any loop */
+	bool RunNode(const FLoopNodeSetup& Setup, const TArray<int32>& LoopCounts, int32 Repeats, TArray<FCompileRow>& OutRows)
+	{
+		FCompileMeasurement Empty;
+		if (!Measure(Setup, 0, Repeats, Empty))
+		{
+			return false;
+		}
+
+		for (const int32 NumLoops : LoopCounts)
+		{
+			FCompileMeasurement Measurement;
+			if (!Measure(Setup, NumLoops, Repeats, Measurement))
+			{
+				return false;
+			}
+
+			FCompileRow& Row = OutRows.AddDefaulted_GetRef();
+			Row.Node = Setup.NodeName;
+			Row.NumLoops = NumLoops;
+			Row.CompileMs = Measurement.CompileMs;
+			Row.CompileMsPerLoop = FMath::Max(0.0, Measurement.CompileMs - Empty.CompileMs) / NumLoops;
+			Row.IntermediateNodes = Measurement.IntermediateNodes;
+			Row.IntermediateNodesPerLoop = static_cast<double>(Measurement.IntermediateNodes - Empty.IntermediateNodes) / NumLoops;
+
+			UE_LOG(LogForEachMapCompileBenchmark, Display, TEXT("%-18s %6d loops  %9.2f ms  (%7.3f ms/loop)  %7d nodes  (%6.1f nodes/loop)"),
+				*Row.Node, Row.NumLoops, Row.CompileMs, Row.CompileMsPerLoop, Row.IntermediateNodes, Row.IntermediateNodesPerLoop);
+		}
+
+		return true;
+	}
+
+	/** The budget is kept per node, from the run with the most loops since that averages the noise out best */
+	TMap<FString, const FCompileRow*> GetBudgetRows(const TArray<FCompileRow>& Rows)
+	{
+		TMap<FString, const FCompileRow*> BudgetRows;
+		for (const FCompileRow& Row : Rows)
+		{
+			const FCompileRow*& BudgetRow = BudgetRows.FindOrAdd(Row.Node, nullptr);
+			if (BudgetRow == nullptr || Row.NumLoops > BudgetRow->NumLoops)
+			{
+				BudgetRow = &Row;
+			}
+		}
+		return BudgetRows;
+	}
+
+	bool SaveBudget(const TArray<FCompileRow>& Rows, const FString& Path)
+	{
+		const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		for (const TPair<FString, const FCompileRow*>& Pair : GetBudgetRows(Rows))
+		{
+			const TSharedRef<FJsonObject> Budget = MakeShared<FJsonObject>();
+			Budget->SetNumberField(TEXT("numLoops"), Pair.Value->NumLoops);
+			Budget->SetNumberField(TEXT("compileMsPerLoop"), Pair.Value->CompileMsPerLoop);
+			Budget->SetNumberField(TEXT("intermediateNodesPerLoop"), Pair.Value->IntermediateNodesPerLoop);
+			Root->SetObjectField(Pair.Key, Budget);
+		}
+
+		FString Json;
+		FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json));
+		return FFileHelper::SaveStringToFile(Json, *Path);
+	}
+
+	/**
+	 * Compares against a budget written by -SaveBudget. Node counts are deterministic and may never grow,
+	 * compile times may exceed the budget by the tolerance (0.25 = 25%). Returns the number of violations, or -1 if unreadable.
+	 */
+	int32 CheckBudget(const TArray<FCompileRow>& Rows, const FString& Path, double Tolerance)
+	{
+		FString Json;
+		TSharedPtr<FJsonObject> Root;
+		if (!FFileHelper::LoadFileToString(Json, *Path) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+		{
+			UE_LOG(LogForEachMapCompileBenchmark, Error, TEXT("Failed to read the budget from %s"), *Path);
+			return -1;
+		}
+
+		int32 NumViolations = 0;
+		for (const TPair<FString, const FCompileRow*>& Pair : GetBudgetRows(Rows))
+		{
+			const TSharedPtr<FJsonObject>* Budget = nullptr;
+			if (!Root->TryGetObjectField(Pair.Key, Budget))
+			{
+				UE_LOG(LogForEachMapCompileBenchmark, Warning, TEXT("%s has no budget in %s"), *Pair.Key, *Path);
+				continue;
+			}
+
+			const FCompileRow& Row = *Pair.Value;
+			const double NodeBudget = (*Budget)->GetNumberField(TEXT("intermediateNodesPerLoop"));
+			const double TimeBudget = (*Budget)->GetNumberField(TEXT("compileMsPerLoop"));
+
+			if (Row.IntermediateNodesPerLoop > NodeBudget + KINDA_SMALL_NUMBER)
+			{
+				UE_LOG(LogForEachMapCompileBenchmark, Error, TEXT("%s expands into %.1f nodes per loop, the budget is %.1f"),
+					*Row.Node, Row.IntermediateNodesPerLoop, NodeBudget);
+				++NumViolations;
+			}
+
+			if (Row.CompileMsPerLoop > TimeBudget * (1.0 + Tolerance))
+			{
+				UE_LOG(LogForEachMapCompileBenchmark, Error, TEXT("%s takes %.3f ms per loop to compile, the budget is %.3f ms (+%.0f%%)"),
+					*Row.Node, Row.CompileMsPerLoop, TimeBudget, Tolerance * 100.0);
+				++NumViolations;
+			}
+		}
+
+		return NumViolations;
+	}
+
+	FString WriteCsv(const TArray<FCompileRow>& Rows)
+	{
+		FString Csv = TEXT("Node,NumLoops,CompileMs,CompileMsPerLoop,IntermediateNodes,IntermediateNodesPerLoop\n");
+		for (const FCompileRow& Row : Rows)
+		{
+			Csv += FString::Printf(TEXT("%s,%d,%.3f,%.3f,%d,%.2f\n"),
+				*Row.Node, Row.NumLoops, Row.CompileMs, Row.CompileMsPerLoop, Row.IntermediateNodes, Row.IntermediateNodesPerLoop);
+		}
+		return Csv;
+	}
+
+	FString WriteJson(const TArray<FCompileRow>& Rows)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		for (const FCompileRow& Row : Rows)
+		{
+			TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->SetStringField(TEXT("node"), Row.Node);
+			Object->SetNumberField(TEXT("numLoops"), Row.NumLoops);
+			Object->SetNumberField(TEXT("compileMs"), Row.CompileMs);
+			Object->SetNumberField(TEXT("compileMsPerLoop"), Row.CompileMsPerLoop);
+			Object->SetNumberField(TEXT("intermediateNodes"), Row.IntermediateNodes);
+			Object->SetNumberField(TEXT("intermediateNodesPerLoop"), Row.IntermediateNodesPerLoop);
+			Values.Add(MakeShared<FJsonValueObject>(Object));
+		}
+
+		FString Json;
+		FJsonSerializer::Serialize(Values, TJsonWriterFactory<>::Create(&Json));
+		return Json;
+	}
+}
+
+UForEachMapCompileBenchmarkCommandlet::UForEachMapCompileBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UForEachMapCompileBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace ForEachMapCompileBenchmark_Private;
+
+	FString LoopsParam = TEXT("1,10,100,250");
+	FParse::Value(*Params, TEXT("Loops="), LoopsParam, /*bShouldStopOnSeparator=*/ false);
+
+	TArray<FString> LoopStrings;
+	TArray<int32> LoopCounts;
+	LoopsParam.ParseIntoArray(LoopStrings, TEXT(","));
+	for (const FString& LoopString : LoopStrings)
+	{
+		const int32 NumLoops = FCString::Atoi(*LoopString);
+		if (NumLoops < 1)
+		{
+			UE_LOG(LogForEachMapCompileBenchmark, Error, TEXT("Invalid loop count '%s'"), *LoopString);
+			return 1;
+		}
+		LoopCounts.Add(NumLoops);
+	}
+
+	FString NodesParam = TEXT("Map,Set,Array");
+	FParse::Value(*Params, TEXT("Nodes="), NodesParam, /*bShouldStopOnSeparator=*/ false);
+
+	int32 Repeats = 3;
+	FParse::Value(*Params, TEXT("Repeats="), Repeats);
+	Repeats = FMath::Max(Repeats, 1);
+
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("ForEachMapCompileBenchmark.csv");
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	// Plain ints everywhere, we're after what the nodes expand into and not what the types cost
+	FEdGraphPinType IntType;
+	IntType.PinCategory = UEdGraphSchema_K2::PC_Int;
+
+	TArray<FLoopNodeSetup> Setups;
+	if (NodesParam.Contains(TEXT("Map")))
+	{
+		Setups.Add(MakeMapLoop(IntType, IntType));
+	}
+	if (NodesParam.Contains(TEXT("Set")))
+	{
+		Setups.Add(MakeSetLoop(IntType));
+	}
+	if (NodesParam.Contains(TEXT("Array")))
+	{
+		Setups.Add(MakeArrayLoop(IntType));
+	}
+
+	TArray<FCompileRow> Rows;
+	for (const FLoopNodeSetup& Setup : Setups)
+	{
+		if (!RunNode(Setup, LoopCounts, Repeats, Rows))
+		{
+			return 1;
+		}
+	}
+
+	const bool bJson = FPaths::GetExtension(OutputPath).Equals(TEXT("json"), ESearchCase::IgnoreCase);
+	if (!FFileHelper::SaveStringToFile(bJson ? WriteJson(Rows) : WriteCsv(Rows), *OutputPath))
+	{
+		UE_LOG(LogForEachMapCompileBenchmark, Error, TEXT("Failed to write the results to %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogForEachMapCompileBenchmark, Display, TEXT("Wrote %d result(s) to %s"), Rows.Num(), *OutputPath);
+
+	FString SaveBudgetPath;
+	if (FParse::Value(*Params, TEXT("-SaveBudget="), SaveBudgetPath))
+	{
+		if (!SaveBudget(Rows, SaveBudgetPath))
+		{
+			UE_LOG(LogForEachMapCompileBenchmark, Error, TEXT("Failed to write the budget to %s"), *SaveBudgetPath);
+			return 1;
+		}
+		UE_LOG(LogForEachMapCompileBenchmark, Display, TEXT("Wrote the budget to %s"), *SaveBudgetPath);
+	}
+
+	// Only checked when given a budget, one recorded on another machine says little about this one
+	FString BudgetPath;
+	if (FParse::Value(*Params, TEXT("-Budget="), BudgetPath))
+	{
+		double Tolerance = 0.25;
+		FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+
+		const int32 NumViolations = CheckBudget(Rows, BudgetPath, Tolerance);
+		if (NumViolations != 0)
+		{
+			return 1;
+		}
+		UE_LOG(LogForEachMapCompileBenchmark, Display, TEXT("All loop nodes are within the budget in %s"), *BudgetPath);
+	}
+
+	return 0;
+}
@@ -0,0 +1,28 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ForEachMapCompileBenchmarkCommandlet.generated.h"
+
+/**
+ * Measures what the loop nodes cost the Blueprint compiler. Compiles throwaway Blueprints with N loop nodes back to back
+ * and reports the compile time and the nodes left after expansion, per loop node.
+ * Compared against a budget file it fails once a node expands into more nodes, or compiles slower than the tolerance allows.
+ *
+ * UnrealEditor-Cmd <Project> -run=ForEachMapCompileBenchmark -nullrhi [-Loops=1,10,...] [-Nodes=Map,Set,Array] [-Repeats=3]
+ *     [-Output=<File>.csv|.json] [-Budget=<File>.json] [-Tolerance=0.25] [-SaveBudget=<File>.json]
+ */
+UCLASS()
+class UForEachMapCompileBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UForEachMapCompileBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -0,0 +1,793 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "ForEachMapNodeHelpers.h"
+
+#include "ForEachLoopStats.h"
+#include "ForEachMapLibrary.h"
+#include "K2Node_AssignmentStatement.h"
+#include "K2Node_BreakStruct.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_FunctionResult.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_Knot.h"
+#include "K2Node_MakeArray.h"
+#include "K2Node_MakeMap.h"
+#include "K2Node_MakeSet.h"
+#include "K2Node_Self.h"
+#include "K2Node_TemporaryVariable.h"
+#include "K2Node_VariableGet.h"
+#include "KismetCompiler.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+
+#define LOCTEXT_NAMESPACE "ForEachMapNodeHelpers"
+
+namespace TimeSlice_PinNames
+{
+	static const FName BudgetMsPin(TEXT("BudgetMsPin"));
+	static const FName BudgetIterationsPin(TEXT("BudgetIterationsPin"));
+}
+
+namespace Await_PinNames
+{
+	static const FName ContinuePin(TEXT("ContinuePin"));
+}
+
+namespace Range_PinNames
+{
+	static const FName StartPin(TEXT("RangeStartPin"));
+	static const FName CountPin(TEXT("RangeCountPin"));
+	static const FName StridePin(TEXT("RangeStridePin"));
+}
+
+namespace ForEachMapNodeHelpers
+{
+	bool IsReevaluatedPerRead(const UEdGraphPin* InputPin)
+	{
+		if (InputPin == nullptr || InputPin->LinkedTo.Num() == 0)
+		{
+			return false;
+		}
+
+		// Reroute nodes are just cosmetics, look through them
+		const UEdGraphPin* SourcePin = InputPin->LinkedTo[0];
+		while (const UK2Node_Knot* Knot = Cast<UK2Node_Knot>(SourcePin->GetOwningNode()))
+		{
+			const UEdGraphPin* KnotInput = Knot->GetInputPin();
+			if (KnotInput->LinkedTo.Num() == 0)
+			{
+				return false;
+			}
+
+			SourcePin = KnotInput->LinkedTo[0];
+		}
+
+		const UK2Node* SourceNode = Cast<UK2Node>(SourcePin->GetOwningNode());
+		if (SourceNode == nullptr || !SourceNode->IsNodePure())
+		{
+			// Impure nodes write their outputs once, reading those is free
+			return false;
+		}
+
+		// These compile down to plain terms, so there's nothing being re-evaluated
+		return !SourceNode->IsA<UK2Node_VariableGet>() &&
+			!SourceNode->IsA<UK2Node_TemporaryVariable>() &&
+			!SourceNode->IsA<UK2Node_Self>() &&
+			!SourceNode->IsA<UK2Node_BreakStruct>();
+	}
+
+	void CaptureInputOnce(FKismetCompilerContext& CompilerContext, UK2Node* SourceNode, UEdGraph* SourceGraph, UEdGraphPin* ExecPin, UEdGraphPin* InputPin)
+	{
+		if (!IsReevaluatedPerRead(InputPin))
+		{
+			return;
+		}
+
+		const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+		// Local holding the evaluated container for the whole loop
+		UK2Node_TemporaryVariable* CapturedVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(SourceNode, SourceGraph);
+		CapturedVar->VariableType = InputPin->PinType;
+		CapturedVar->VariableType.bIsReference = false;
+		CapturedVar->VariableType.bIsConst = false;
+		CapturedVar->AllocateDefaultPins();
+		UEdGraphPin* Captured_Pin = CapturedVar->GetVariablePin();
+
+		// Captured = Input, once, before the loop is entered
+		UK2Node_AssignmentStatement* Capture = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(SourceNode, SourceGraph);
+		Capture->AllocateDefaultPins();
+		Schema->TryCreateConnection(Capture->GetVariablePin(), Captured_Pin);
+
+		CompilerContext.MovePinLinksToIntermediate(*InputPin, *Capture->GetValuePin());
+		Capture->NotifyPinConnectionListChanged(Capture->GetValuePin());
+
+		CompilerContext.MovePinLinksToIntermediate(*ExecPin, *Capture->GetExecPin());
+		Capture->GetThenPin()->MakeLinkTo(ExecPin);
+
+		// From here on everything reads the local
+		InputPin->MakeLinkTo(Captured_Pin);
+	}
+
+	FName MakeLoopScopeName(const UBlueprint* Blueprint, const UEdGraphNode* PlacedNode)
+	{
+		const FString ScopeName = FString::Printf(TEXT("%s.%s [%s]"),
+			*GetNameSafe(Blueprint),
+			*PlacedNode->GetNodeTitle(ENodeTitleType::MenuTitle).ToString(),
+			*PlacedNode->NodeGuid.ToString());
+
+		return FName(*ScopeName);
+	}
+
+	/**
+	 * Whether following the exec wires out of ExecPin can end up in a Return node.
+	 * Wires back into the node owning ExecPin (Break) aren't followed, whatever comes after it (Completed) runs once it is done anyway.
+	 */
+	static bool CanReachFunctionResult(const UEdGraphPin* ExecPin)
+	{
+		TSet<const UEdGraphNode*> Visited = { ExecPin->GetOwningNode() };
+		TArray<const UEdGraphPin*, TInlineAllocator<16>> PinsToFollow = { ExecPin };
+		while (PinsToFollow.Num() > 0)
+		{
+			for (const UEdGraphPin* LinkedPin : PinsToFollow.Pop()->LinkedTo)
+			{
+				const UEdGraphNode* Node = LinkedPin->GetOwningNode();
+				bool bAlreadyVisited = false;
+				Visited.Add(Node, &bAlreadyVisited);
+				if (bAlreadyVisited)
+				{
+					continue;
+				}
+
+				if (Node->IsA<UK2Node_FunctionResult>())
+				{
+					return true;
+				}
+
+				for (const UEdGraphPin* Pin : Node->Pins)
+				{
+					if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
+					{
+						PinsToFollow.Add(Pin);
+					}
+				}
+			}
+		}
+
+		return false;
+	}
+
+	void WrapInTraceScope(FKismetCompilerContext& CompilerContext, UK2Node* SourceNode, UEdGraph* SourceGraph, UEdGraphPin* ExecPin, const UEdGraphPin* LoopBodyPin, UEdGraphPin* CompletedPin)
+	{
+		// Returning from within the body never reaches End, the scope would straddle everything up to the end of the frame
+		if (CanReachFunctionResult(LoopBodyPin))
+		{
+			return;
+		}
+
+		// Intermediate loops (the ones For Each Map / Set expand into) resolve to the node the user can actually find in the graph
+		const UEdGraphNode* PlacedNode = Cast<UEdGraphNode>(CompilerContext.MessageLog.FindSourceObject(SourceNode));
+		if (PlacedNode == nullptr)
+		{
+			PlacedNode = SourceNode;
+		}
+
+		const FString ScopeName = MakeLoopScopeName(CompilerContext.Blueprint, PlacedNode).ToString();
+
+		auto SpawnTraceFunc = [&](const FName FunctionName) -> UK2Node_CallFunction*
+		{
+			UK2Node_CallFunction* CallFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(SourceNode, SourceGraph);
+			CallFunc->FunctionReference.SetExternalMember(FunctionName, UForEachMapLibrary::StaticClass());
+			CallFunc->AllocateDefaultPins();
+			CallFunc->FindPinChecked(TEXT("ScopeName"))->DefaultValue = ScopeName;
+			return CallFunc;
+		};
+
+		// Begin runs first, then whatever ExecPin leads to
+		UK2Node_CallFunction* BeginFunc = SpawnTraceFunc(GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Trace_LoopBegin));
+		CompilerContext.MovePinLinksToIntermediate(*ExecPin, *BeginFunc->GetExecPin());
+		BeginFunc->GetThenPin()->MakeLinkTo(ExecPin);
+
+		// End runs last, before whatever followed Completed
+		UK2Node_CallFunction* EndFunc = SpawnTraceFunc(GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Trace_LoopEnd));
+		CompilerContext.MovePinLinksToIntermediate(*CompletedPin, *EndFunc->GetThenPin());
+		CompletedPin->MakeLinkTo(EndFunc->GetExecPin());
+	}
+
+	/** Counters of the node's runs, only while ForEachMap.Stats is on so the graph editor doesn't pay for it otherwise */
+	static bool FindLoopStats(const UK2Node* Node, FForEachLoopNodeStats& OutStats)
+	{
+		if (!FForEachLoopStats::IsEnabled())
+		{
+			return false;
+		}
+
+		const UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(Node);
+		return Blueprint && FForEachLoopStats::Find(MakeLoopScopeName(Blueprint, Node), OutStats);
+	}
+
+	FText AppendLoopStats(const UK2Node* Node, ENodeTitleType::Type TitleType, const FText& Title)
+	{
+		// Menu titles name the trace scope, they have to stay as they are
+		FForEachLoopNodeStats Stats;
+		if (TitleType != ENodeTitleType::FullTitle || !FindLoopStats(Node, Stats))
+		{
+			return Title;
+		}
+
+		FNumberFormattingOptions MsFormat;
+		MsFormat.MinimumFractionalDigits = 3;
+		MsFormat.MaximumFractionalDigits = 3;
+
+		return FText::Format(LOCTEXT("LoopStats", "{0}\n{1} runs, {2} iterations, {3} ms avg"),
+			Title,
+			FText::AsNumber(Stats.Invocations),
+			FText::AsNumber(Stats.Iterations),
+			FText::AsNumber(Stats.GetAverageMs(), &MsFormat));
+	}
+
+	FLinearColor GetLoopHeatColor(const UK2Node* Node, const FLinearColor& Color)
+	{
+		FForEachLoopNodeStats Stats;
+		const double HottestSeconds = FForEachLoopStats::GetHottestSeconds();
+		if (HottestSeconds <= 0.0 || !FindLoopStats(Node, Stats))
+		{
+			return Color;
+		}
+
+		const float Heat = static_cast<float>(FMath::Clamp(Stats.TotalSeconds / HottestSeconds, 0.0, 1.0));
+		return FLinearColor::LerpUsingHSV(Color, FLinearColor::Red, Heat);
+	}
+
+	/**
+	 * Spells the literal of a key pin the way the map / set would compare it, so literals the container would merge end up equal.
+	 * Strings and names hash without case, numbers by value (floats after rounding to float). False for types we don't know how to compare.
+	 */
+	static bool GetLiteralKey(const UEdGraphPin* Pin, FString& OutKey)
+	{
+		const FEdGraphPinType& PinType = Pin->PinType;
+		const FName Category = PinType.PinCategory;
+		const FString Literal = Pin->GetDefaultAsString();
+
+		if (Category == UEdGraphSchema_K2::PC_Int || Category == UEdGraphSchema_K2::PC_Int64
+			|| (Category == UEdGraphSchema_K2::PC_Byte && PinType.PinSubCategoryObject == nullptr))
+		{
+			int64 Value = 0;
+			LexFromString(Value, *Literal);
+			OutKey = LexToString(Value);
+			return true;
+		}
+
+		if (Category == UEdGraphSchema_K2::PC_Real)
+		{
+			double Value = 0.0;
+			LexFromString(Value, *Literal);
+			if (PinType.PinSubCategory == UEdGraphSchema_K2::PC_Float)
+			{
+				Value = static_cast<float>(Value);
+			}
+
+			// 0 and -0 are the same key
+			OutKey = FString::Printf(TEXT("%.17g"), Value == 0.0 ? 0.0 : Value);
+			return true;
+		}
+
+		if (Category == UEdGraphSchema_K2::PC_Boolean)
+		{
+			OutKey = LexToString(Literal.ToBool());
+			return true;
+		}
+
+		if (Category == UEdGraphSchema_K2::PC_String || Category == UEdGraphSchema_K2::PC_Name
+			|| Category == UEdGraphSchema_K2::PC_Byte || Category == UEdGraphSchema_K2::PC_Enum
+			|| Category == UEdGraphSchema_K2::PC_SoftObject || Category == UEdGraphSchema_K2::PC_SoftClass)
+		{
+			OutKey = Literal.ToLower();
+			return true;
+		}
+
+		if (Category == UEdGraphSchema_K2::PC_Object || Category == UEdGraphSchema_K2::PC_Class)
+		{
+			OutKey = GetPathNameSafe(Pin->DefaultObject);
+			return true;
+		}
+
+		// Structs and the like compare member by member, their literals can't be matched as text
+		return false;
+	}
+
+	bool TryUnrollLiteralLoop(FKismetCompilerContext& CompilerContext, UK2Node* SourceNode, UEdGraph* SourceGraph, const FUnrollPins& Pins)
+	{
+		if (Pins.Container->LinkedTo.Num() != 1)
+		{
+			return false;
+		}
+
+		const UK2Node_MakeContainer* MakeNode = Cast<UK2Node_MakeContainer>(Pins.Container->LinkedTo[0]->GetOwningNode());
+		const bool bIsMap = MakeNode && MakeNode->IsA<UK2Node_MakeMap>();
+		if (!MakeNode || bIsMap != (Pins.Value != nullptr))
+		{
+			return false;
+		}
+
+		// Make Map creates its pins as Key 0, Value 0, Key 1, ... so pairs sit next to each other
+		TArray<const UEdGraphPin*> EntryPins;
+		for (const UEdGraphPin* Pin : MakeNode->Pins)
+		{
+			if (Pin->Direction != EGPD_Input || Pin->bOrphanedPin)
+			{
+				continue;
+			}
+
+			// Anything wired in is only known at runtime
+			if (Pin->LinkedTo.Num() > 0)
+			{
+				return false;
+			}
+
+			EntryPins.Add(Pin);
+		}
+
+		const int32 Stride = bIsMap ? 2 : 1;
+		const int32 NumEntries = EntryPins.Num() / Stride;
+		if (NumEntries > MaxUnrolledEntries)
+		{
+			return false;
+		}
+
+		// Maps and sets drop duplicate keys, leave those to the real thing rather than mimicking which entry wins
+		if (!MakeNode->IsA<UK2Node_MakeArray>())
+		{
+			TSet<FString> Keys;
+			for (int32 Entry = 0; Entry < NumEntries; ++Entry)
+			{
+				FString Key;
+				if (!GetLiteralKey(EntryPins[Entry * Stride], Key))
+				{
+					return false;
+				}
+
+				bool bIsDuplicate = false;
+				Keys.Add(MoveTemp(Key), &bIsDuplicate);
+				if (bIsDuplicate)
+				{
+					return false;
+				}
+			}
+		}
+
+		const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+		// Locals the outputs read from, only for the ones that are actually used
+		auto SpawnOutputVar = [&](UEdGraphPin* OutputPin) -> UEdGraphPin*
+		{
+			if (OutputPin == nullptr || OutputPin->LinkedTo.Num() == 0)
+			{
+				return nullptr;
+			}
+
+			UK2Node_TemporaryVariable* OutputVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(SourceNode, SourceGraph);
+			OutputVar->VariableType = OutputPin->PinType;
+			OutputVar->VariableType.bIsReference = false;
+			OutputVar->VariableType.bIsConst = false;
+			OutputVar->AllocateDefaultPins();
+			CompilerContext.MovePinLinksToIntermediate(*OutputPin, *OutputVar->GetVariablePin());
+			return OutputVar->GetVariablePin();
+		};
+
+		UEdGraphPin* Key_Pin = SpawnOutputVar(Pins.Key);
+		UEdGraphPin* Value_Pin = SpawnOutputVar(Pins.Value);
+		UEdGraphPin* Index_Pin = SpawnOutputVar(Pins.Index);
+
+		// Assigns a constant to one of the locals, chained after Then. Returns the new end of the chain
+		auto ChainAssignment = [&](UEdGraphPin* Then, UEdGraphPin* VariablePin, const UEdGraphPin* LiteralPin, const FString& LiteralValue) -> UEdGraphPin*
+		{
+			if (VariablePin == nullptr)
+			{
+				return Then;
+			}
+
+			UK2Node_AssignmentStatement* Assign = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(SourceNode, SourceGraph);
+			Assign->AllocateDefaultPins();
+			Schema->TryCreateConnection(Assign->GetVariablePin(), VariablePin);
+
+			UEdGraphPin* Assign_Value = Assign->GetValuePin();
+			if (LiteralPin != nullptr)
+			{
+				Assign_Value->DefaultValue = LiteralPin->DefaultValue;
+				Assign_Value->DefaultObject = LiteralPin->DefaultObject;
+				Assign_Value->DefaultTextValue = LiteralPin->DefaultTextValue;
+			}
+			else
+			{
+				Assign_Value->DefaultValue = LiteralValue;
+			}
+
+			Then->MakeLinkTo(Assign->GetExecPin());
+			return Assign->GetThenPin();
+		};
+
+		// Breaking just raises a flag, the remaining entries check it before they run
+		UEdGraphPin* Broken_Pin = nullptr;
+		UEdGraphPin* Entry_Pin = Pins.Exec;
+		if (Pins.Break && Pins.Break->LinkedTo.Num() > 0)
+		{
+			UK2Node_TemporaryVariable* BrokenVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(SourceNode, SourceGraph);
+			BrokenVar->VariableType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+			BrokenVar->AllocateDefaultPins();
+			Broken_Pin = BrokenVar->GetVariablePin();
+
+			UK2Node_AssignmentStatement* Init_Broken = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(SourceNode, SourceGraph);
+			Init_Broken->AllocateDefaultPins();
+			CompilerContext.MovePinLinksToIntermediate(*Pins.Exec, *Init_Broken->GetExecPin());
+			Schema->TryCreateConnection(Init_Broken->GetVariablePin(), Broken_Pin);
+			Init_Broken->GetValuePin()->DefaultValue = TEXT("false");
+			Entry_Pin = Init_Broken->GetThenPin();
+
+			UK2Node_AssignmentStatement* Set_Broken = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(SourceNode, SourceGraph);
+			Set_Broken->AllocateDefaultPins();
+			CompilerContext.MovePinLinksToIntermediate(*Pins.Break, *Set_Broken->GetExecPin());
+			Schema->TryCreateConnection(Set_Broken->GetVariablePin(), Broken_Pin);
+			Set_Broken->GetValuePin()->DefaultValue = TEXT("true");
+		}
+
+		// One sequence output per entry, the last one completes the loop
+		UK2Node_ExecutionSequence* SequenceNode = CompilerContext.SpawnIntermediateNode<UK2Node_ExecutionSequence>(SourceNode, SourceGraph);
+		SequenceNode->AllocateDefaultPins();
+		while (SequenceNode->GetThenPinGivenIndex(NumEntries) == nullptr)
+		{
+			SequenceNode->AddInputPin();
+		}
+
+		if (Entry_Pin == Pins.Exec)
+		{
+			CompilerContext.MovePinLinksToIntermediate(*Pins.Exec, *SequenceNode->GetExecPin());
+		}
+		else
+		{
+			Entry_Pin->MakeLinkTo(SequenceNode->GetExecPin());
+		}
+
+		for (int32 Entry = 0; Entry < NumEntries; ++Entry)
+		{
+			UEdGraphPin* Then = SequenceNode->GetThenPinGivenIndex(Entry);
+			if (Broken_Pin != nullptr)
+			{
+				UK2Node_IfThenElse* BrokenBranch = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(SourceNode, SourceGraph);
+				BrokenBranch->AllocateDefaultPins();
+				Then->MakeLinkTo(BrokenBranch->GetExecPin());
+				BrokenBranch->GetConditionPin()->MakeLinkTo(Broken_Pin);
+				Then = BrokenBranch->GetElsePin();
+			}
+
+			Then = ChainAssignment(Then, Key_Pin, EntryPins[Entry * Stride], FString());
+			Then = ChainAssignment(Then, Value_Pin, bIsMap ? EntryPins[Entry * Stride + 1] : nullptr, FString());
+			Then = ChainAssignment(Then, Index_Pin, nullptr, LexToString(Entry));
+			CompilerContext.CopyPinLinksToIntermediate(*Pins.LoopBody, *Then);
+		}
+
+		CompilerContext.MovePinLinksToIntermediate(*Pins.Completed, *SequenceNode->GetThenPinGivenIndex(NumEntries));
+		return true;
+	}
+
+	void CreateTimeSlicePins(UK2Node* Node)
+	{
+		// INPUT: Milliseconds per frame
+		UEdGraphPin* BudgetMsPin =
+			Node->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Real, UEdGraphSchema_K2::PC_Double, TimeSlice_PinNames::BudgetMsPin);
+		if (ensure(BudgetMsPin))
+		{
+			BudgetMsPin->PinFriendlyName = LOCTEXT("BudgetMsPin_FriendlyName", "Budget (ms)");
+			BudgetMsPin->PinToolTip = LOCTEXT("BudgetMsPin_ToolTip", "Milliseconds the loop may spend per frame before it waits for the next one. Zero or less means no time limit.").ToString();
+			BudgetMsPin->DefaultValue = TEXT("1.0");
+		}
+
+		// INPUT: Iterations per frame
+		UEdGraphPin* BudgetIterationsPin =
+			Node->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Int, TimeSlice_PinNames::BudgetIterationsPin);
+		if (ensure(BudgetIterationsPin))
+		{
+			BudgetIterationsPin->PinFriendlyName = LOCTEXT("BudgetIterationsPin_FriendlyName", "Budget (Iterations)");
+			BudgetIterationsPin->PinToolTip = LOCTEXT("BudgetIterationsPin_ToolTip", "Iterations the loop may run per frame before it waits for the next one. Zero or less means no iteration limit.").ToString();
+			BudgetIterationsPin->DefaultValue = TEXT("0");
+		}
+	}
+
+	UEdGraphPin* GetBudgetMsPin(const UK2Node* Node)
+	{
+		return Node->FindPin(TimeSlice_PinNames::BudgetMsPin);
+	}
+
+	UEdGraphPin* GetBudgetIterationsPin(const UK2Node* Node)
+	{
+		return Node->FindPin(TimeSlice_PinNames::BudgetIterationsPin);
+	}
+
+	void MoveTimeSlicePinsToIntermediate(FKismetCompilerContext& CompilerContext, const UK2Node* SourceNode, const UK2Node* IntermediateNode)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*GetBudgetMsPin(SourceNode), *GetBudgetMsPin(IntermediateNode));
+		CompilerContext.MovePinLinksToIntermediate(*GetBudgetIterationsPin(SourceNode), *GetBudgetIterationsPin(IntermediateNode));
+	}
+
+	void CreateContinuePin(UK2Node* Node)
+	{
+		// INPUT: Continue, moves on to the next entry
+		UEdGraphPin* ContinuePin =
+			Node->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, Await_PinNames::ContinuePin);
+		if (ensure(ContinuePin))
+		{
+			ContinuePin->PinFriendlyName = LOCTEXT("ContinuePin_FriendlyName", "Continue");
+			ContinuePin->PinToolTip = LOCTEXT("ContinuePin_ToolTip", "Fire once the loop body is done with the current entry, after any Delay or async wait, to move on to the next one.").ToString();
+		}
+	}
+
+	UEdGraphPin* GetContinuePin(const UK2Node* Node)
+	{
+		return Node->FindPin(Await_PinNames::ContinuePin);
+	}
+
+	void CreateRangePins(UK2Node* Node)
+	{
+		// INPUT: First entry to visit
+		UEdGraphPin* StartPin =
+			Node->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Int, Range_PinNames::StartPin);
+		if (ensure(StartPin))
+		{
+			StartPin->PinFriendlyName = LOCTEXT("RangeStartPin_FriendlyName", "Start");
+			StartPin->PinToolTip = LOCTEXT("RangeStartPin_ToolTip", "How many entries to skip before the first visit, counted in walk order.").ToString();
+			StartPin->DefaultValue = TEXT("0");
+		}
+
+		// INPUT: Number of visits
+		UEdGraphPin* CountPin =
+			Node->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Int, Range_PinNames::CountPin);
+		if (ensure(CountPin))
+		{
+			CountPin->PinFriendlyName = LOCTEXT("RangeCountPin_FriendlyName", "Count");
+			CountPin->PinToolTip = LOCTEXT("RangeCountPin_ToolTip", "How many entries to visit at most. A negative count visits all of them.").ToString();
+			CountPin->DefaultValue = TEXT("-1");
+		}
+
+		// INPUT: Distance between visits
+		UEdGraphPin* StridePin =
+			Node->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Int, Range_PinNames::StridePin);
+		if (ensure(StridePin))
+		{
+			StridePin->PinFriendlyName = LOCTEXT("RangeStridePin_FriendlyName", "Stride");
+			StridePin->PinToolTip = LOCTEXT("RangeStridePin_ToolTip", "Visits every Nth entry. One (or less) visits every entry.").ToString();
+			StridePin->DefaultValue = TEXT("1");
+		}
+	}
+
+	void MoveRangePinsToIntermediate(FKismetCompilerContext& CompilerContext, const UK2Node* SourceNode, const UK2Node* IntermediateNode)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*SourceNode->FindPinChecked(Range_PinNames::StartPin), *IntermediateNode->FindPinChecked(Range_PinNames::StartPin));
+		CompilerContext.MovePinLinksToIntermediate(*SourceNode->FindPinChecked(Range_PinNames::CountPin), *IntermediateNode->FindPinChecked(Range_PinNames::CountPin));
+		CompilerContext.MovePinLinksToIntermediate(*SourceNode->FindPinChecked(Range_PinNames::StridePin), *IntermediateNode->FindPinChecked(Range_PinNames::StridePin));
+	}
+
+	void ConnectRangedNext(FKismetCompilerContext& CompilerContext, const UK2Node* SourceNode, UK2Node_CallFunction* NextFunc, bool bReverse)
+	{
+		UEdGraphPin* Next_Start = NextFunc->FindPinChecked(TEXT("Start"));
+		UEdGraphPin* Next_Count = NextFunc->FindPinChecked(TEXT("Count"));
+		UEdGraphPin* Next_Stride = NextFunc->FindPinChecked(TEXT("Stride"));
+
+		if (SourceNode->FindPin(Range_PinNames::StartPin))
+		{
+			CompilerContext.MovePinLinksToIntermediate(*SourceNode->FindPinChecked(Range_PinNames::StartPin), *Next_Start);
+			CompilerContext.MovePinLinksToIntermediate(*SourceNode->FindPinChecked(Range_PinNames::CountPin), *Next_Count);
+			CompilerContext.MovePinLinksToIntermediate(*SourceNode->FindPinChecked(Range_PinNames::StridePin), *Next_Stride);
+		}
+		else
+		{
+			// Reversed only, the whole container
+			Next_Start->DefaultValue = TEXT("0");
+			Next_Count->DefaultValue = TEXT("-1");
+			Next_Stride->DefaultValue = TEXT("1");
+		}
+
+		NextFunc->FindPinChecked(TEXT("bReverse"))->DefaultValue = LexToString(bReverse);
+	}
+
+	bool CheckLoopModeForErrors(const FKismetCompilerContext& CompilerContext, UK2Node* Node, EForEachLoopMode LoopMode)
+	{
+		if (LoopMode == EForEachLoopMode::Immediate)
+		{
+			return false;
+		}
+
+		// We're looking at a copy while compiling, the graph the user placed the node in is what counts.
+		// Only event graphs keep their locals alive across frames, the loop state would be gone once we're back
+		const UEdGraphNode* SourceNode = Cast<UEdGraphNode>(CompilerContext.MessageLog.FindSourceObject(Node));
+		const UEdGraph* Graph = SourceNode ? SourceNode->GetGraph() : Node->GetGraph();
+		if (Graph && Graph->GetSchema()->GetGraphType(Graph) == GT_Function)
+		{
+			const FText Message = LoopMode == EForEachLoopMode::TimeSliced
+				? LOCTEXT("LatentLoopInFunction", "@@ waits for the next frame between slices, which is only possible in event graphs.")
+				: LOCTEXT("AwaitableLoopInFunction", "@@ waits for Continue between entries, which is only possible in event graphs.");
+			CompilerContext.MessageLog.Error(*Message.ToString(), Node);
+			return true;
+		}
+
+		if (LoopMode == EForEachLoopMode::Awaitable)
+		{
+			const UEdGraphPin* ContinuePin = GetContinuePin(Node);
+			if (ContinuePin && ContinuePin->LinkedTo.Num() == 0)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("AwaitableNeverContinued", "Continue of @@ is not connected, the loop stops after the first entry.").ToString(),
+					Node);
+			}
+		}
+
+		return false;
+	}
+
+	bool CheckOrderForErrors(const FKismetCompilerContext& CompilerContext, UK2Node* Node, EForEachOrder Order, const FEdGraphPinType& KeyType, const FEdGraphPinType* ValueType)
+	{
+		if (Order == EForEachOrder::Unordered)
+		{
+			return false;
+		}
+
+		const bool bByValue = Order == EForEachOrder::ValueAscending || Order == EForEachOrder::ValueDescending;
+		if (bByValue && ValueType == nullptr)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("OrderByValueWithoutValue", "@@ can't be ordered by value, sets only have elements.").ToString(),
+				Node);
+			return true;
+		}
+
+		// Mirrors the property types the runtime knows how to compare
+		static const FName OrderableCategories[] =
+		{
+			UEdGraphSchema_K2::PC_Int,
+			UEdGraphSchema_K2::PC_Int64,
+			UEdGraphSchema_K2::PC_Byte,
+			UEdGraphSchema_K2::PC_Enum,
+			UEdGraphSchema_K2::PC_Real,
+			UEdGraphSchema_K2::PC_String,
+			UEdGraphSchema_K2::PC_Name,
+			UEdGraphSchema_K2::PC_Text,
+		};
+
+		const FEdGraphPinType& SortType = bByValue ? *ValueType : KeyType;
+		if (!MakeArrayView(OrderableCategories).Contains(SortType.PinCategory))
+		{
+			CompilerContext.MessageLog.Error(
+				*FText::Format(LOCTEXT("OrderByUnorderableType", "@@ can't be ordered by {0}, only numbers, enums, strings, names and text can be sorted."),
+					UEdGraphSchema_K2::TypeToText(SortType)).ToString(),
+				Node);
+			return true;
+		}
+
+		return false;
+	}
+
+	bool IsPlainOldDataType(const FEdGraphPinType& PinType)
+	{
+		if (PinType.IsContainer())
+		{
+			return false;
+		}
+
+		// Bools are left out on purpose, their properties may be bitfields
+		const FName Category = PinType.PinCategory;
+		if (Category == UEdGraphSchema_K2::PC_Int ||
+			Category == UEdGraphSchema_K2::PC_Int64 ||
+			Category == UEdGraphSchema_K2::PC_Byte ||
+			Category == UEdGraphSchema_K2::PC_Enum ||
+			Category == UEdGraphSchema_K2::PC_Real ||
+			Category == UEdGraphSchema_K2::PC_Name)
+		{
+			return true;
+		}
+
+		// Vectors, int points and the like, anything without non-trivial members
+		if (Category == UEdGraphSchema_K2::PC_Struct)
+		{
+			const UScriptStruct* Struct = Cast<UScriptStruct>(PinType.PinSubCategoryObject.Get());
+			return Struct && (Struct->StructFlags & STRUCT_IsPlainOldData) != 0;
+		}
+
+		return false;
+	}
+
+	void ReconnectPins(UK2Node* Node, UEdGraphPin* Pin)
+	{
+		TArray<UEdGraphPin*> LinkedPins = Pin->LinkedTo;
+		Pin->BreakAllPinLinks(true);
+
+		const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+		for (UEdGraphPin* Connection : LinkedPins)
+		{
+			Schema->TryCreateConnection( Pin, Connection);
+		}
+
+		Node->GetGraph()->NotifyGraphChanged();
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Node->GetBlueprint());
+	}
+
+	bool IsEntryFunction(const UFunction* Function, const FEdGraphPinType& ContainerPinType, bool bIsPredicate)
+	{
+		if (Function == nullptr)
+		{
+			return false;
+		}
+
+		const bool bIsMap = ContainerPinType.ContainerType == EPinContainerType::Map;
+		const bool bIsResolved = ContainerPinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard;
+
+		// What the function has to take, in order
+		TArray<FEdGraphPinType, TInlineAllocator<2>> ArgumentTypes;
+		ArgumentTypes.Add(FEdGraphPinType::GetTerminalTypeForContainer(ContainerPinType));
+		if (bIsMap)
+		{
+			ArgumentTypes.Add(FEdGraphPinType::GetPinTypeForTerminalType(ContainerPinType.PinValueType));
+		}
+
+		const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+		int32 NumParams = 0;
+		bool bReturnsBool = false;
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			if (It->HasAnyPropertyFlags(CPF_ReturnParm))
+			{
+				bReturnsBool = It->IsA<FBoolProperty>();
+				continue;
+			}
+
+			// Inputs only, references are fine since they point at a copy
+			if (It->HasAnyPropertyFlags(CPF_OutParm) && !It->HasAnyPropertyFlags(CPF_ReferenceParm))
+			{
+				return false;
+			}
+
+			const int32 ParamIndex = NumParams++;
+			if (!bIsResolved)
+			{
+				continue;
+			}
+
+			FEdGraphPinType ParamType;
+			if (!ArgumentTypes.IsValidIndex(ParamIndex) || !Schema->ConvertPropertyToPinType(*It, ParamType))
+			{
+				return false;
+			}
+
+			const FEdGraphPinType& ArgumentType = ArgumentTypes[ParamIndex];
+			if (ParamType.PinCategory != ArgumentType.PinCategory ||
+				ParamType.PinSubCategory != ArgumentType.PinSubCategory ||
+				ParamType.PinSubCategoryObject != ArgumentType.PinSubCategoryObject ||
+				ParamType.ContainerType != ArgumentType.ContainerType)
+			{
+				return false;
+			}
+		}
+
+		const bool bHasReturn = Function->GetReturnProperty() != nullptr;
+		return NumParams == ArgumentTypes.Num() && (bIsPredicate ? bReturnsBool : !bHasReturn);
+	}
+
+	TArray<FString> GetFunctionNames(const UBlueprint* Blueprint, TFunctionRef<bool(const UFunction*)> Filter)
+	{
+		TArray<FString> Names;
+		if (Blueprint && Blueprint->SkeletonGeneratedClass)
+		{
+			for (TFieldIterator<UFunction> It(Blueprint->SkeletonGeneratedClass, EFieldIteratorFlags::IncludeSuper); It; ++It)
+			{
+				if (Filter(*It))
+				{
+					Names.Add(It->GetName());
+				}
+			}
+		}
+
+		Names.Sort();
+		return Names;
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,131 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphNode.h"
+#include "ForEachLoopTypes.h"
+
+class FKismetCompilerContext;
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+class UEdGraphPin;
+class UK2Node;
+class UK2Node_CallFunction;
+struct FEdGraphPinType;
+
+/** Expansion helpers shared by the loop nodes */
+namespace ForEachMapNodeHelpers
+{
+	/** Pins of a loop node that take part in unrolling it, Value only exists for maps */
+	struct FUnrollPins
+	{
+		UEdGraphPin* Exec = nullptr;
+		UEdGraphPin* Container = nullptr;
+		UEdGraphPin* Break = nullptr;
+		UEdGraphPin* LoopBody = nullptr;
+		UEdGraphPin* Key = nullptr;
+		UEdGraphPin* Value = nullptr;
+		UEdGraphPin* Index = nullptr;
+		UEdGraphPin* Completed = nullptr;
+	};
+
+	/** Literal containers with more entries than this are looped over as usual, unrolling them would only bloat the bytecode */
+	static constexpr int32 MaxUnrolledEntries = 32;
+
+	/**
+	 * Whether every read of the given input pin re-runs the node feeding it.
+	 * That is the case for pure nodes, except for the ones that merely name a variable (getters, self, struct members).
+	 */
+	bool IsReevaluatedPerRead(const UEdGraphPin* InputPin);
+
+	/**
+	 * Makes sure the container feeding InputPin is evaluated exactly once per loop.
+	 * If reading it would re-run an upstream pure node, its result gets captured into a local when the loop is entered,
+	 * and InputPin (as well as ExecPin) are rewired through that. Otherwise nothing changes and the container keeps being read by reference.
+	 */
+	void CaptureInputOnce(FKismetCompilerContext& CompilerContext, UK2Node* SourceNode, UEdGraph* SourceGraph, UEdGraphPin* ExecPin, UEdGraphPin* InputPin);
+
+	/**
+	 * Wraps a loop run into Trace_LoopBegin / Trace_LoopEnd calls, so it shows up in Insights while ForEachMap.Trace is on.
+	 * The scope is named after the Blueprint and the GUID of the node the user placed. ExecPin and CompletedPin get rewired
+	 * through the calls, the expansion carries on with them as usual. Only for loops that complete within the frame they started in.
+	 * Loops whose body can Return out of the function are left alone, their scope would stay open over whatever runs after the function.
+	 */
+	void WrapInTraceScope(FKismetCompilerContext& CompilerContext, UK2Node* SourceNode, UEdGraph* SourceGraph, UEdGraphPin* ExecPin, const UEdGraphPin* LoopBodyPin, UEdGraphPin* CompletedPin);
+
+	/** Name the runs of a placed loop node are traced and counted under, built from its Blueprint, menu title and GUID */
+	FName MakeLoopScopeName(const UBlueprint* Blueprint, const UEdGraphNode* PlacedNode);
+
+	/** Adds the runs, iterations and average time of the node below its full title, while ForEachMap.Stats is on and the node has run */
+	FText AppendLoopStats(const UK2Node* Node, ENodeTitleType::Type TitleType, const FText& Title);
+
+	/** Tints Color towards red the more time the node took compared to the hottest loop node, while ForEachMap.Stats is on */
+	FLinearColor GetLoopHeatColor(const UK2Node* Node, const FLinearColor& Color);
+
+	/**
+	 * Unrolls the loop if its container comes straight out of a Make Map, Make Set or Make Array with literal entries only.
+	 * The loop body then runs once per literal with the outputs assigned from constants, and no container gets built at all.
+	 * The caller has to make sure none of its options need the container. Returns true if the pins got rewired, false if the loop has to be expanded as usual.
+	 */
+	bool TryUnrollLiteralLoop(FKismetCompilerContext& CompilerContext, UK2Node* SourceNode, UEdGraph* SourceGraph, const FUnrollPins& Pins);
+
+	/** Creates the per-frame budget pins of a time-sliced loop */
+	void CreateTimeSlicePins(UK2Node* Node);
+
+	/** Budget pin accessors, null unless the node is time-sliced */
+	UEdGraphPin* GetBudgetMsPin(const UK2Node* Node);
+	UEdGraphPin* GetBudgetIterationsPin(const UK2Node* Node);
+
+	/** Hands the budget pins of a time-sliced loop over to the intermediate node doing the actual work */
+	void MoveTimeSlicePinsToIntermediate(FKismetCompilerContext& CompilerContext, const UK2Node* SourceNode, const UK2Node* IntermediateNode);
+
+	/** Creates the Continue pin of an awaitable loop */
+	void CreateContinuePin(UK2Node* Node);
+
+	/** Continue pin accessor, null unless the node is awaitable */
+	UEdGraphPin* GetContinuePin(const UK2Node* Node);
+
+	/** Creates the Start, Count and Stride pins of a ranged loop */
+	void CreateRangePins(UK2Node* Node);
+
+	/** Hands the range pins over to the intermediate loop node, both have to be ranged */
+	void MoveRangePinsToIntermediate(FKismetCompilerContext& CompilerContext, const UK2Node* SourceNode, const UK2Node* IntermediateNode);
+
+	/** Feeds the range of SourceNode into a RangedIteratorNext call. A node without range pins (reversed only) walks everything */
+	void ConnectRangedNext(FKismetCompilerContext& CompilerContext, const UK2Node* SourceNode, UK2Node_CallFunction* NextFunc, bool bReverse);
+
+	/**
+	 * Reports an error if the loop mode can't be used in the graph the node was placed in. Returns true on error.
+	 * Warns about awaitable loops nobody continues as well.
+	 */
+	bool CheckLoopModeForErrors(const FKismetCompilerContext& CompilerContext, UK2Node* Node, EForEachLoopMode LoopMode);
+
+	/**
+	 * Reports an error if the loop can't be ordered the requested way.
+	 * Sorting works on numbers, enums, strings, names and text. ValueType is null for sets. Returns true on error
+	 */
+	bool CheckOrderForErrors(const FKismetCompilerContext& CompilerContext, UK2Node* Node, EForEachOrder Order, const FEdGraphPinType& KeyType, const FEdGraphPinType* ValueType);
+
+	/**
+	 * Whether values of the given (non-container) pin type can be copied byte by byte.
+	 * Lets the loops fetch keys and values through the plain old data fast path rather than through their properties.
+	 */
+	bool IsPlainOldDataType(const FEdGraphPinType& PinType);
+
+	/**
+	 * Breaks the links of Pin and tries to make them again, after its type changed.
+	 * Links that don't fit the new type anymore are dropped.
+	 */
+	void ReconnectPins(UK2Node* Node, UEdGraphPin* Pin);
+
+	/**
+	 * Whether Function takes exactly the entries of the container as inputs, (Key, Value) for maps and (Element) for sets.
+	 * Predicates have to return a bool on top, anything else must not return anything. While the container is still a wildcard only the inputs are counted.
+	 */
+	bool IsEntryFunction(const UFunction* Function, const FEdGraphPinType& ContainerPinType, bool bIsPredicate);
+
+	/** Names of the Blueprint's functions that pass the filter, for the function pickers of the details panel */
+	TArray<FString> GetFunctionNames(const UBlueprint* Blueprint, TFunctionRef<bool(const UFunction*)> Filter);
+}
@@ -0,0 +1,323 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "K2Node_FilterContainer.h"
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "ForEachMapLibrary.h"
+#include "ForEachMapNodeHelpers.h"
+#include "K2Node_CallFunction.h"
+#include "KismetCompiler.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(K2Node_FilterContainer)
+
+#define LOCTEXT_NAMESPACE "K2Node_FilterContainer"
+
+namespace FilterContainer_PinNames
+{
+	static const FName ContainerPin(TEXT("ContainerPin"));
+	static const FName FilteredPin(TEXT("FilteredPin"));
+}
+
+void UK2Node_FilterContainer::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	Super::GetMenuActions(ActionRegistrar);
+
+	UClass* Action = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(Action))
+	{
+		// Same node for both containers, the spawner decides which one it is
+		auto AddSpawner = [&](EPinContainerType InContainerType, const FText& MenuName)
+		{
+			UBlueprintNodeSpawner* GetNodeSpawner = UBlueprintNodeSpawner::Create(Action);
+			check(GetNodeSpawner != nullptr);
+
+			GetNodeSpawner->DefaultMenuSignature.MenuName = MenuName;
+			GetNodeSpawner->CustomizeNodeDelegate = UBlueprintNodeSpawner::FCustomizeNodeDelegate::CreateLambda(
+				[InContainerType](UEdGraphNode* NewNode, bool /*bIsTemplateNode*/)
+				{
+					CastChecked<UK2Node_FilterContainer>(NewNode)->ContainerType = InContainerType;
+				});
+
+			ActionRegistrar.AddBlueprintAction(Action, GetNodeSpawner);
+		};
+
+		AddSpawner(EPinContainerType::Map, LOCTEXT("NodeTitle_Map", "Filter Map"));
+		AddSpawner(EPinContainerType::Set, LOCTEXT("NodeTitle_Set", "Filter Set"));
+	}
+}
+
+FText UK2Node_FilterContainer::GetMenuCategory() const
+{
+	return LOCTEXT("NodeMenuCategory", "Utilities|Array");
+}
+
+void UK2Node_FilterContainer::AllocateDefaultPins()
+{
+	Super::AllocateDefaultPins();
+
+	const bool bIsMap = ContainerType == EPinContainerType::Map;
+	check(bIsMap || ContainerType == EPinContainerType::Set);
+
+	// Add default pins here
+	// INPUT: Exec
+	UEdGraphPin* ExecPin =
+		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute);
+	if (ensure(ExecPin))
+	{
+		ExecPin->PinFriendlyName = LOCTEXT("ExecPin_FriendlyName", "Execute");
+	}
+
+	FCreatePinParams _params;
+	_params.ContainerType = ContainerType;
+	_params.ValueTerminalType.TerminalCategory = UEdGraphSchema_K2::PC_Wildcard;
+
+	// INPUT: Container Type
+	UEdGraphPin* ContainerPin =
+		CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, FilterContainer_PinNames::ContainerPin, _params);
+	if (ensure(ContainerPin))
+	{
+		ContainerPin->PinType.bIsConst = true;
+		ContainerPin->PinType.bIsReference = true;
+		ContainerPin->PinFriendlyName = bIsMap ? LOCTEXT( "MapPin_FriendlyName", "Map" ) : LOCTEXT( "SetPin_FriendlyName", "Set" );
+	}
+
+	// OUTPUT: Then
+	CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then);
+
+	// OUTPUT: Filtered container, same type as the input
+	UEdGraphPin* FilteredPin =
+		CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, FilterContainer_PinNames::FilteredPin, _params);
+	if (ensure(FilteredPin))
+	{
+		FilteredPin->PinFriendlyName = LOCTEXT( "FilteredPin_FriendlyName", "Filtered" );
+	}
+
+	if (CachedInputType.PinCategory == NAME_None)
+	{
+		CachedInputWildcardType = CachedInputType = ContainerPin->PinType;
+	}
+	else
+	{
+		ContainerPin->PinType = CachedInputType;
+		FilteredPin->PinType = CachedInputType;
+		FilteredPin->PinType.bIsConst = false;
+		FilteredPin->PinType.bIsReference = false;
+	}
+}
+
+void UK2Node_FilterContainer::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	if (CheckForErrors( CompilerContext ))
+	{
+		BreakAllNodeLinks( );
+		return;
+	}
+
+	const bool bIsMap = ContainerType == EPinContainerType::Map;
+
+	// A single native call does all the work, the predicate name is baked in as a literal
+	UK2Node_CallFunction* FilterFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	FilterFunc->FunctionReference.SetExternalMember(
+		bIsMap ? GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_Filter) : GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Set_Filter),
+		UForEachMapLibrary::StaticClass());
+	FilterFunc->AllocateDefaultPins();
+
+	UEdGraphPin* Filter_Container = FilterFunc->FindPinChecked(bIsMap ? TEXT("TargetMap") : TEXT("TargetSet"));
+	CompilerContext.MovePinLinksToIntermediate(*GetInputContainerPin(), *Filter_Container);
+	FilterFunc->PinConnectionListChanged(Filter_Container);
+
+	CompilerContext.MovePinLinksToIntermediate(*GetFilteredPin(), *FilterFunc->FindPinChecked(bIsMap ? TEXT("FilteredMap") : TEXT("FilteredSet")));
+	FilterFunc->FindPinChecked(TEXT("FunctionName"))->DefaultValue = FunctionName.ToString();
+
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *FilterFunc->GetExecPin());
+	CompilerContext.MovePinLinksToIntermediate(*FindPinChecked(UEdGraphSchema_K2::PN_Then), *FilterFunc->GetThenPin());
+
+	// Break the links as the native call will handle the rest
+	BreakAllNodeLinks();
+}
+
+FText UK2Node_FilterContainer::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	const FText Title = ContainerType == EPinContainerType::Set
+		? LOCTEXT("NodeTitle_Set", "Filter Set")
+		: LOCTEXT("NodeTitle_Map", "Filter Map");
+
+	if (TitleType == ENodeTitleType::FullTitle && !FunctionName.IsNone())
+	{
+		return FText::Format(LOCTEXT("NodeTitle_WithFunction", "{0}\nBy {1}"), Title, FText::FromName(FunctionName));
+	}
+
+	return Title;
+}
+
+FText UK2Node_FilterContainer::GetTooltipText() const
+{
+	return LOCTEXT("NodeTooltip", "Builds a new container out of the entries the picked predicate function returns true for.");
+}
+
+FText UK2Node_FilterContainer::GetKeywords() const
+{
+	return FText::FromString(TEXT("Filter,Where,Select,Map,Set"));
+}
+
+FSlateIcon UK2Node_FilterContainer::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static const FSlateIcon Icon = FSlateIcon(FAppStyle::GetAppStyleSetName(), "GraphEditor.Macro.ForEach_16x");
+	OutColor = FLinearColor::White;
+	return Icon;
+}
+
+FLinearColor UK2Node_FilterContainer::GetNodeTitleColor() const
+{
+	return FLinearColor::White;
+}
+
+void UK2Node_FilterContainer::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	Super::PinConnectionListChanged(Pin);
+
+	if (Pin == nullptr)
+	{
+		return;
+	}
+
+	UEdGraphPin* ContainerPin = GetInputContainerPin();
+	UEdGraphPin* FilteredPin = GetFilteredPin();
+
+	if (Pin == FilteredPin && ContainerPin->LinkedTo.Num() <= 0)
+	{
+		if (FilteredPin->LinkedTo.Num() > 0)
+		{
+			// Output got wired first, let it decide the type for both sides
+			FilteredPin->PinType = FilteredPin->LinkedTo[0]->PinType;
+			FilteredPin->PinType.bIsConst = false;
+			FilteredPin->PinType.bIsReference = false;
+
+			ContainerPin->PinType = FilteredPin->PinType;
+			ContainerPin->PinType.bIsConst = true;
+			ContainerPin->PinType.bIsReference = true;
+			CachedInputType = ContainerPin->PinType;
+		}
+		else
+		{
+			// If we're connected to nothing, reset all those pin types
+			ContainerPin->PinType = FilteredPin->PinType = CachedInputType = CachedInputWildcardType;
+		}
+
+		GetGraph()->NotifyGraphChanged();
+	}
+
+	if (Pin == ContainerPin)
+	{
+		bool bShouldReconnect = false;
+		if (Pin->LinkedTo.Num() > 0)
+		{
+			const UEdGraphPin* FirstPin = Pin->LinkedTo[0];
+
+			// Only reconnect if the pin type has actually changed
+			bShouldReconnect = Pin->PinType != FirstPin->PinType;
+
+			Pin->PinType = FirstPin->PinType;
+			FilteredPin->PinType = FirstPin->PinType;
+			FilteredPin->PinType.bIsConst = false;
+			FilteredPin->PinType.bIsReference = false;
+		}
+		else if (FilteredPin->LinkedTo.Num() <= 0)
+		{
+			// If we have no connections anymore, reset pin types
+			Pin->PinType = FilteredPin->PinType = CachedInputWildcardType;
+			bShouldReconnect = true;
+		}
+
+		CachedInputType = Pin->PinType;
+
+		if (bShouldReconnect)
+		{
+			ForEachMapNodeHelpers::ReconnectPins(this, FilteredPin);
+		}
+	}
+}
+
+void UK2Node_FilterContainer::PostPasteNode()
+{
+	Super::PostPasteNode();
+
+	if (UEdGraphPin* ContainerPin = GetInputContainerPin())
+	{
+		if (!ContainerPin->LinkedTo.Num())
+		{
+			ContainerPin->PinType = GetFilteredPin()->PinType = CachedInputType = CachedInputWildcardType;
+		}
+	}
+}
+
+void UK2Node_FilterContainer::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, FunctionName))
+	{
+		// Poke the graph to update the title
+		GetGraph()->NotifyGraphChanged();
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+}
+
+UEdGraphPin* UK2Node_FilterContainer::GetInputContainerPin() const
+{
+	return FindPinChecked(FilterContainer_PinNames::ContainerPin);
+}
+
+UEdGraphPin* UK2Node_FilterContainer::GetFilteredPin() const
+{
+	return FindPinChecked(FilterContainer_PinNames::FilteredPin);
+}
+
+TArray<FString> UK2Node_FilterContainer::GetFunctionNameOptions() const
+{
+	const FEdGraphPinType& ContainerPinType = GetInputContainerPin()->PinType;
+	return ForEachMapNodeHelpers::GetFunctionNames(GetBlueprint(), [&ContainerPinType](const UFunction* Function)
+	{
+		return ForEachMapNodeHelpers::IsEntryFunction(Function, ContainerPinType, true);
+	});
+}
+
+bool UK2Node_FilterContainer::CheckForErrors(const FKismetCompilerContext& CompilerContext)
+{
+	if (GetInputContainerPin()->LinkedTo.Num() == 0)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT( "NoContainerEntry", "Filter node @@ requires a map or set input.").ToString(),
+			this);
+		return true;
+	}
+
+	const UBlueprint* Blueprint = GetBlueprint();
+	const UFunction* Function = Blueprint && Blueprint->SkeletonGeneratedClass ? Blueprint->SkeletonGeneratedClass->FindFunctionByName(FunctionName) : nullptr;
+	if (Function == nullptr)
+	{
+		CompilerContext.MessageLog.Error(
+			*FText::Format(LOCTEXT( "FunctionNotFound", "Filter node @@ could not find predicate '{0}'."), FText::FromName(FunctionName)).ToString(),
+			this);
+		return true;
+	}
+
+	if (!ForEachMapNodeHelpers::IsEntryFunction(Function, GetInputContainerPin()->PinType, true))
+	{
+		CompilerContext.MessageLog.Error(
+			*FText::Format(LOCTEXT( "FunctionIncompatible", "Filter node @@ can't use '{0}' as predicate. It has to take {1} as its only inputs and return a bool."),
+				FText::FromName(FunctionName),
+				ContainerType == EPinContainerType::Map ? LOCTEXT("MapArguments", "(Key, Value)") : LOCTEXT("SetArguments", "(Element)")).ToString(),
+			this);
+		return true;
+	}
+
+	return false;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,433 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "K2Node_ForEachBatch.h"
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "ForEachMapLibrary.h"
+#include "ForEachMapNodeHelpers.h"
+#include "K2Node_AssignmentStatement.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_TemporaryVariable.h"
+#include "KismetCompiler.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(K2Node_ForEachBatch)
+
+#define LOCTEXT_NAMESPACE "K2Node_ForEachBatch"
+
+namespace ForEachBatch_PinNames
+{
+	static const FName ContainerPin(TEXT("ContainerPin"));
+	static const FName BatchSizePin(TEXT("BatchSizePin"));
+	static const FName BreakPin(TEXT("BreakPin"));
+	static const FName KeysPin(TEXT("KeysPin"));
+	static const FName ValuesPin(TEXT("ValuesPin"));
+	static const FName BatchStartPin(TEXT("BatchStartPin"));
+	static const FName CompletedPin(TEXT("CompletedPin"));
+}
+
+void UK2Node_ForEachBatch::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	Super::GetMenuActions(ActionRegistrar);
+
+	UClass* Action = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(Action))
+	{
+		// Same node for both containers, the spawner decides which one it is
+		auto AddSpawner = [&](EPinContainerType InContainerType, const FText& MenuName)
+		{
+			UBlueprintNodeSpawner* GetNodeSpawner = UBlueprintNodeSpawner::Create(Action);
+			check(GetNodeSpawner != nullptr);
+
+			GetNodeSpawner->DefaultMenuSignature.MenuName = MenuName;
+			GetNodeSpawner->CustomizeNodeDelegate = UBlueprintNodeSpawner::FCustomizeNodeDelegate::CreateLambda(
+				[InContainerType](UEdGraphNode* NewNode, bool /*bIsTemplateNode*/)
+				{
+					CastChecked<UK2Node_ForEachBatch>(NewNode)->ContainerType = InContainerType;
+				});
+
+			ActionRegistrar.AddBlueprintAction(Action, GetNodeSpawner);
+		};
+
+		AddSpawner(EPinContainerType::Map, LOCTEXT("NodeTitle_Map", "For Each Map (Batched)"));
+		AddSpawner(EPinContainerType::Set, LOCTEXT("NodeTitle_Set", "For Each Set (Batched)"));
+	}
+}
+
+FText UK2Node_ForEachBatch::GetMenuCategory() const
+{
+	return LOCTEXT("NodeMenuCategory", "Utilities|Array");
+}
+
+void UK2Node_ForEachBatch::AllocateDefaultPins()
+{
+	Super::AllocateDefaultPins();
+
+	const bool bIsMap = ContainerType == EPinContainerType::Map;
+	check(bIsMap || ContainerType == EPinContainerType::Set);
+
+	// Add default pins here
+	// INPUT: Exec
+	UEdGraphPin* ExecPin =
+		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute);
+	if (ensure(ExecPin))
+	{
+		ExecPin->PinFriendlyName = LOCTEXT("ExecPin_FriendlyName", "Execute");
+	}
+
+	FCreatePinParams _params;
+	_params.ContainerType = ContainerType;
+	_params.ValueTerminalType.TerminalCategory = UEdGraphSchema_K2::PC_Wildcard;
+
+	// INPUT: Container Type
+	UEdGraphPin* ContainerPin =
+		CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, ForEachBatch_PinNames::ContainerPin, _params);
+	if (ensure(ContainerPin))
+	{
+		ContainerPin->PinType.bIsConst = true;
+		ContainerPin->PinType.bIsReference = true;
+		ContainerPin->PinFriendlyName = bIsMap ? LOCTEXT( "MapPin_FriendlyName", "Map" ) : LOCTEXT( "SetPin_FriendlyName", "Set" );
+	}
+
+	// INPUT: Batch Size
+	UEdGraphPin* BatchSizePin =
+		CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Int, ForEachBatch_PinNames::BatchSizePin);
+	if (ensure(BatchSizePin))
+	{
+		BatchSizePin->DefaultValue = TEXT("64");
+		BatchSizePin->PinFriendlyName = LOCTEXT( "BatchSizePin_FriendlyName", "Batch Size" );
+		BatchSizePin->PinToolTip = LOCTEXT( "BatchSizePin_ToolTip", "Entries per chunk, only the last chunk may hold fewer." ).ToString();
+	}
+
+	// INPUT: Break
+	UEdGraphPin* BreakPin =
+		CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, ForEachBatch_PinNames::BreakPin);
+	if (ensure(BreakPin))
+	{
+		BreakPin->PinFriendlyName = LOCTEXT( "BreakPin_FriendlyName", "Break" );
+	}
+
+	// OUTPUT: Loop Body Exec
+	UEdGraphPin* LoopBodyPin =
+		CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then);
+	if (ensure(LoopBodyPin))
+	{
+		LoopBodyPin->PinFriendlyName = LOCTEXT( "LoopBodyPin_FriendlyName", "Loop Body" );
+	}
+
+	FCreatePinParams _arrayParams;
+	_arrayParams.ContainerType = EPinContainerType::Array;
+
+	// OUTPUT: Keys (or Elements) of the chunk
+	UEdGraphPin* KeysPin =
+		CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, ForEachBatch_PinNames::KeysPin, _arrayParams);
+	if (ensure(KeysPin))
+	{
+		KeysPin->PinFriendlyName = bIsMap ? LOCTEXT( "KeysPin_FriendlyName", "Keys" ) : LOCTEXT( "ElementsPin_FriendlyName", "Elements" );
+	}
+
+	// OUTPUT: Values of the chunk, lined up with Keys
+	if (bIsMap)
+	{
+		UEdGraphPin* ValuesPin =
+			CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, ForEachBatch_PinNames::ValuesPin, _arrayParams);
+		if (ensure(ValuesPin))
+		{
+			ValuesPin->PinFriendlyName = LOCTEXT( "ValuesPin_FriendlyName", "Values" );
+		}
+	}
+
+	// OUTPUT: Batch Start
+	UEdGraphPin* BatchStartPin =
+		CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Int, ForEachBatch_PinNames::BatchStartPin);
+	if (ensure(BatchStartPin))
+	{
+		BatchStartPin->PinFriendlyName = LOCTEXT( "BatchStartPin_FriendlyName", "Batch Start" );
+		BatchStartPin->PinToolTip = LOCTEXT( "BatchStartPin_ToolTip", "Index of the chunk's first entry within the whole loop." ).ToString();
+	}
+
+	// OUTPUT: Completed Exec
+	UEdGraphPin* CompletedPin =
+		CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, ForEachBatch_PinNames::CompletedPin);
+	if (ensure(CompletedPin))
+	{
+		CompletedPin->PinFriendlyName = LOCTEXT( "CompletedPin_FriendlyName", "Completed" );
+	}
+
+	if (CachedInputType.PinCategory == NAME_None)
+	{
+		CachedInputWildcardType = CachedInputType = ContainerPin->PinType;
+	}
+	else
+	{
+		ContainerPin->PinType = CachedInputType;
+	}
+
+	PropagateContainerType();
+}
+
+void UK2Node_ForEachBatch::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	if (CheckForErrors( CompilerContext ))
+	{
+		BreakAllNodeLinks( );
+		return;
+	}
+
+	const bool bIsMap = ContainerType == EPinContainerType::Map;
+	const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+	UEdGraphPin* ContainerPin = GetInputContainerPin();
+
+	// Batched loops never span frames, every run gets its own trace scope
+	ForEachMapNodeHelpers::WrapInTraceScope(CompilerContext, this, SourceGraph, GetExecPin(), GetLoopBodyPin(), GetCompletedPin());
+
+	// A pure source would be re-run by every chunk, evaluate it once up front instead
+	ForEachMapNodeHelpers::CaptureInputOnce(CompilerContext, this, SourceGraph, GetExecPin(), ContainerPin);
+
+	// Local holding the sparse index of the last entry handed out
+	UK2Node_TemporaryVariable* SparseIndexVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+	SparseIndexVar->VariableType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	SparseIndexVar->AllocateDefaultPins();
+	UEdGraphPin* SparseIndex_Pin = SparseIndexVar->GetVariablePin();
+
+	// Local holding the logical index of the chunk's first entry
+	UK2Node_TemporaryVariable* IndexVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+	IndexVar->VariableType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	IndexVar->AllocateDefaultPins();
+	UEdGraphPin* Index_Pin = IndexVar->GetVariablePin();
+	CompilerContext.MovePinLinksToIntermediate(*GetBatchStartPin(), *Index_Pin);
+
+	// Local holding the size of the chunk handed out last, the body may resize the output arrays so those can't tell
+	UK2Node_TemporaryVariable* ChunkNumVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+	ChunkNumVar->VariableType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	ChunkNumVar->AllocateDefaultPins();
+	UEdGraphPin* ChunkNum_Pin = ChunkNumVar->GetVariablePin();
+
+	// SparseIndex = Index = INDEX_NONE, the first Next moves both onto the first chunk
+	UK2Node_AssignmentStatement* Init_SparseIndex = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
+	Init_SparseIndex->AllocateDefaultPins();
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *Init_SparseIndex->GetExecPin());
+	Schema->TryCreateConnection(Init_SparseIndex->GetVariablePin(), SparseIndex_Pin);
+	Init_SparseIndex->GetValuePin()->DefaultValue = LexToString(INDEX_NONE);
+
+	UK2Node_AssignmentStatement* Init_Index = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
+	Init_Index->AllocateDefaultPins();
+	Init_SparseIndex->GetThenPin()->MakeLinkTo(Init_Index->GetExecPin());
+	Schema->TryCreateConnection(Init_Index->GetVariablePin(), Index_Pin);
+	Init_Index->GetValuePin()->DefaultValue = LexToString(INDEX_NONE);
+
+	// BatchNext(Container, SparseIndex, Index, ChunkNum, BatchSize) copies the next chunk into its output arrays.
+	// Those live on as locals of the call, so the body reads the same arrays every chunk and they keep their allocation
+	UK2Node_CallFunction* NextFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	NextFunc->FunctionReference.SetExternalMember(
+		bIsMap ? GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_BatchNext) : GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Set_BatchNext),
+		UForEachMapLibrary::StaticClass());
+	NextFunc->AllocateDefaultPins();
+
+	UEdGraphPin* Next_Container = NextFunc->FindPinChecked(bIsMap ? TEXT("TargetMap") : TEXT("TargetSet"));
+	CompilerContext.MovePinLinksToIntermediate(*ContainerPin, *Next_Container);
+	NextFunc->PinConnectionListChanged(Next_Container);
+
+	NextFunc->FindPinChecked(TEXT("SparseIndex"))->MakeLinkTo(SparseIndex_Pin);
+	NextFunc->FindPinChecked(TEXT("Index"))->MakeLinkTo(Index_Pin);
+	NextFunc->FindPinChecked(TEXT("ChunkNum"))->MakeLinkTo(ChunkNum_Pin);
+	CompilerContext.MovePinLinksToIntermediate(*GetBatchSizePin(), *NextFunc->FindPinChecked(TEXT("BatchSize")));
+
+	UEdGraphPin* Next_Keys = NextFunc->FindPinChecked(bIsMap ? TEXT("Keys") : TEXT("Elements"));
+	Next_Keys->PinType = GetKeysPin()->PinType;
+	CompilerContext.MovePinLinksToIntermediate(*GetKeysPin(), *Next_Keys);
+
+	if (bIsMap)
+	{
+		UEdGraphPin* Next_Values = NextFunc->FindPinChecked(TEXT("Values"));
+		Next_Values->PinType = GetValuesPin()->PinType;
+		CompilerContext.MovePinLinksToIntermediate(*GetValuesPin(), *Next_Values);
+	}
+
+	Init_Index->GetThenPin()->MakeLinkTo(NextFunc->GetExecPin());
+
+	// Loop condition, was there anything left for another chunk?
+	UK2Node_IfThenElse* BranchCond = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
+	BranchCond->AllocateDefaultPins();
+	NextFunc->GetThenPin()->MakeLinkTo(BranchCond->GetExecPin());
+	BranchCond->GetConditionPin()->MakeLinkTo(NextFunc->GetReturnValuePin());
+	CompilerContext.MovePinLinksToIntermediate(*GetCompletedPin(), *BranchCond->GetElsePin());
+
+	// Loop body first, advance afterward
+	UK2Node_ExecutionSequence* SequenceFunc = CompilerContext.SpawnIntermediateNode<UK2Node_ExecutionSequence>(this, SourceGraph);
+	SequenceFunc->AllocateDefaultPins();
+	BranchCond->GetThenPin()->MakeLinkTo(SequenceFunc->GetExecPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetLoopBodyPin(), *SequenceFunc->GetThenPinGivenIndex(0));
+	SequenceFunc->GetThenPinGivenIndex(1)->MakeLinkTo(NextFunc->GetExecPin());
+
+	// Breaking parks the sparse index on IteratorEnd, which Next never leaves again
+	UK2Node_AssignmentStatement* Break_SparseIndex = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
+	Break_SparseIndex->AllocateDefaultPins();
+	CompilerContext.MovePinLinksToIntermediate(*GetBreakPin(), *Break_SparseIndex->GetExecPin());
+	Schema->TryCreateConnection(Break_SparseIndex->GetVariablePin(), SparseIndex_Pin);
+	Break_SparseIndex->GetValuePin()->DefaultValue = LexToString(UForEachMapLibrary::IteratorEnd);
+
+	// Done, the intermediate nodes took over
+	BreakAllNodeLinks();
+}
+
+FText UK2Node_ForEachBatch::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return ForEachMapNodeHelpers::AppendLoopStats(this, TitleType, ContainerType == EPinContainerType::Set
+		? LOCTEXT("NodeTitle_Set", "For Each Set (Batched)")
+		: LOCTEXT("NodeTitle_Map", "For Each Map (Batched)"));
+}
+
+FText UK2Node_ForEachBatch::GetTooltipText() const
+{
+	return LOCTEXT("NodeTooltip", "Loop over each chunk of Batch Size entries, the Loop Body gets the chunk's entries as arrays along with the index of its first entry.");
+}
+
+FText UK2Node_ForEachBatch::GetKeywords() const
+{
+	return FText::FromString(TEXT("For,Each,Loop,Map,Set,Batch,Chunk"));
+}
+
+FSlateIcon UK2Node_ForEachBatch::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static const FSlateIcon Icon = FSlateIcon(FAppStyle::GetAppStyleSetName(), "GraphEditor.Macro.ForEach_16x");
+	OutColor = FLinearColor::White;
+	return Icon;
+}
+
+FLinearColor UK2Node_ForEachBatch::GetNodeTitleColor() const
+{
+	return ForEachMapNodeHelpers::GetLoopHeatColor(this, FLinearColor::White);
+}
+
+void UK2Node_ForEachBatch::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	Super::PinConnectionListChanged(Pin);
+
+	if (Pin == nullptr)
+	{
+		return;
+	}
+
+	if (Pin->PinName == ForEachBatch_PinNames::ContainerPin)
+	{
+		Pin->PinType = Pin->LinkedTo.Num() > 0 ? Pin->LinkedTo[0]->PinType : CachedInputWildcardType;
+		CachedInputType = Pin->PinType;
+
+		PropagateContainerType();
+
+		ForEachMapNodeHelpers::ReconnectPins(this, GetKeysPin());
+		if (UEdGraphPin* ValuesPin = GetValuesPin())
+		{
+			ForEachMapNodeHelpers::ReconnectPins(this, ValuesPin);
+		}
+
+		GetGraph()->NotifyGraphChanged();
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+}
+
+void UK2Node_ForEachBatch::PostPasteNode()
+{
+	Super::PostPasteNode();
+
+	if (UEdGraphPin* ContainerPin = GetInputContainerPin())
+	{
+		if (!ContainerPin->LinkedTo.Num())
+		{
+			ContainerPin->PinType = CachedInputType = CachedInputWildcardType;
+			PropagateContainerType();
+		}
+	}
+}
+
+void UK2Node_ForEachBatch::PropagateContainerType()
+{
+	const FEdGraphPinType& ContainerPinType = GetInputContainerPin()->PinType;
+
+	// Key (or element) terminal sits on the pin type itself
+	UEdGraphPin* KeysPin = GetKeysPin();
+	KeysPin->PinType.PinCategory = ContainerPinType.PinCategory;
+	KeysPin->PinType.PinSubCategory = ContainerPinType.PinSubCategory;
+	KeysPin->PinType.PinSubCategoryObject = ContainerPinType.PinSubCategoryObject;
+
+	// Value terminal only exists for maps
+	if (UEdGraphPin* ValuesPin = GetValuesPin())
+	{
+		const FEdGraphTerminalType& ValueType = ContainerPinType.PinValueType;
+		ValuesPin->PinType.PinCategory = ValueType.TerminalCategory;
+		ValuesPin->PinType.PinSubCategory = ValueType.TerminalSubCategory;
+		ValuesPin->PinType.PinSubCategoryObject = ValueType.TerminalSubCategoryObject;
+	}
+}
+
+UEdGraphPin* UK2Node_ForEachBatch::GetInputContainerPin() const
+{
+	return FindPinChecked(ForEachBatch_PinNames::ContainerPin);
+}
+
+UEdGraphPin* UK2Node_ForEachBatch::GetBatchSizePin() const
+{
+	return FindPinChecked(ForEachBatch_PinNames::BatchSizePin);
+}
+
+UEdGraphPin* UK2Node_ForEachBatch::GetBreakPin() const
+{
+	return FindPinChecked(ForEachBatch_PinNames::BreakPin);
+}
+
+UEdGraphPin* UK2Node_ForEachBatch::GetLoopBodyPin() const
+{
+	return FindPinChecked(UEdGraphSchema_K2::PN_Then);
+}
+
+UEdGraphPin* UK2Node_ForEachBatch::GetKeysPin() const
+{
+	return FindPinChecked(ForEachBatch_PinNames::KeysPin);
+}
+
+UEdGraphPin* UK2Node_ForEachBatch::GetValuesPin() const
+{
+	return FindPin(ForEachBatch_PinNames::ValuesPin);
+}
+
+UEdGraphPin* UK2Node_ForEachBatch::GetBatchStartPin() const
+{
+	return FindPinChecked(ForEachBatch_PinNames::BatchStartPin);
+}
+
+UEdGraphPin* UK2Node_ForEachBatch::GetCompletedPin() const
+{
+	return FindPinChecked(ForEachBatch_PinNames::CompletedPin);
+}
+
+bool UK2Node_ForEachBatch::CheckForErrors(const FKismetCompilerContext& CompilerContext)
+{
+	if (GetInputContainerPin()->LinkedTo.Num() == 0)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT( "NoContainerEntry", "For Each (Batched) node @@ requires a map or set input.").ToString(),
+			this);
+		return true;
+	}
+
+	// A literal below one would never make progress, the runtime clamps linked values the same way
+	const UEdGraphPin* BatchSizePin = GetBatchSizePin();
+	if (BatchSizePin->LinkedTo.Num() == 0 && FCString::Atoi(*BatchSizePin->DefaultValue) < 1)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT( "InvalidBatchSize", "Batch Size of @@ has to be at least 1.").ToString(),
+			this);
+		return true;
+	}
+
+	return false;
+}
+
+#undef LOCTEXT_NAMESPACE
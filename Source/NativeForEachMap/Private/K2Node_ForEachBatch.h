@@ -0,0 +1,63 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "K2Node.h"
+#include "K2Node_ForEachBatch.generated.h"
+
+/**
+ * Loops over a map or set in chunks, the body fires once per chunk with the chunk's keys and values as arrays.
+ * Pays one VM round trip per chunk instead of one per entry, which is what dominates tight loops over large containers.
+ */
+UCLASS(CollapseCategories)
+class NATIVEFOREACHMAP_API UK2Node_ForEachBatch : public UK2Node
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UK2Node Interface
+	virtual bool IsNodeSafeToIgnore() const override { return true; }
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	//~ End UK2Node Interface
+
+	//~ Begin UEdGraphNode Interface
+	virtual void AllocateDefaultPins() override;
+	virtual void ExpandNode(class FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetTooltipText() const override;
+	virtual FText GetKeywords() const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+	virtual void PostPasteNode() override;
+	//~ End UEdGraphNode Interface
+
+	/** Pin Accessors, the values pin only exists for maps */
+	[[nodiscard]] UEdGraphPin* GetInputContainerPin() const;
+	[[nodiscard]] UEdGraphPin* GetBatchSizePin() const;
+	[[nodiscard]] UEdGraphPin* GetBreakPin() const;
+	[[nodiscard]] UEdGraphPin* GetLoopBodyPin() const;
+	[[nodiscard]] UEdGraphPin* GetKeysPin() const;
+	[[nodiscard]] UEdGraphPin* GetValuesPin() const;
+	[[nodiscard]] UEdGraphPin* GetBatchStartPin() const;
+	[[nodiscard]] UEdGraphPin* GetCompletedPin() const;
+
+	/** Which container we run over, either Map or Set. Assigned by the menu action that spawned us */
+	UPROPERTY()
+	EPinContainerType ContainerType = EPinContainerType::Map;
+
+protected:
+	/** Performs a generalized CheckForErrors lookup. */
+	virtual bool CheckForErrors(const FKismetCompilerContext& CompilerContext);
+
+	/** Gives the chunk arrays the key and value types of the container, or turns them back into wildcards */
+	void PropagateContainerType();
+
+	/** Cached off types for the input pins */
+	UPROPERTY()
+	FEdGraphPinType CachedInputWildcardType;
+	UPROPERTY()
+	FEdGraphPinType CachedInputType;
+};
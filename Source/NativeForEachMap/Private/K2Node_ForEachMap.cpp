@@ -5,10 +5,10 @@
 
 #include "BlueprintActionDatabaseRegistrar.h"
 #include "BlueprintNodeSpawner.h"
+#include "ForEachMapNodeHelpers.h"
 #include "K2Node_CallFunction.h"
-#include "K2Node_InternalIterate.h"
+#include "K2Node_InternalIterateSparse.h"
 #include "KismetCompiler.h"
-#include "Kismet/BlueprintMapLibrary.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(K2Node_ForEachMap)
@@ -19,8 +19,12 @@ namespace ForEachMap_PinNames
 {
 	static const FName MapPin(TEXT("MapPin"));
 	static const FName BreakPin(TEXT("BreakPin"));
+	static const FName RemovePin(TEXT("RemovePin"));
+	static const FName SetValuePin(TEXT("SetValuePin"));
+	static const FName NewValuePin(TEXT("NewValuePin"));
 	static const FName KeyPin(TEXT("KeyPin"));
 	static const FName ValuePin(TEXT("ValuePin"));
+	static const FName ValueSetPin(TEXT("ValueSetPin"));
 	static const FName CompletePin(TEXT("CompletePin"));
 	static const FName IndexPin(TEXT("IndexPin"));
 }
@@ -86,6 +90,52 @@ void UK2Node_ForEachMap::AllocateDefaultPins()
 		BreakPin->PinFriendlyName = LOCTEXT( "BreakPin_FriendlyName", "Break" );
 	}
 
+	// INPUT: Remove Current, takes the current pair out and carries on with the next one
+	UEdGraphPin* RemovePin =
+		CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, ForEachMap_PinNames::RemovePin);
+	if (ensure(RemovePin))
+	{
+		RemovePin->PinFriendlyName = LOCTEXT( "RemovePin_FriendlyName", "Remove Current" );
+		RemovePin->PinToolTip = LOCTEXT( "RemovePin_ToolTip", "Removes the current pair in place, the loop carries on with the next one." ).ToString();
+	}
+
+	// INPUT: Per-frame budget, time-sliced loops only
+	if (LoopMode == EForEachLoopMode::TimeSliced)
+	{
+		ForEachMapNodeHelpers::CreateTimeSlicePins(this);
+	}
+
+	// INPUT: Continue, awaitable loops only
+	if (LoopMode == EForEachLoopMode::Awaitable)
+	{
+		ForEachMapNodeHelpers::CreateContinuePin(this);
+	}
+
+	// INPUT: Start, Count and Stride, ranged loops only
+	if (bRanged)
+	{
+		ForEachMapNodeHelpers::CreateRangePins(this);
+	}
+
+	// INPUT: Set Current Value, writes into the current pair in place
+	UEdGraphPin* SetValuePin =
+		CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, ForEachMap_PinNames::SetValuePin);
+	if (ensure(SetValuePin))
+	{
+		SetValuePin->PinFriendlyName = LOCTEXT( "SetValuePin_FriendlyName", "Set Current Value" );
+		SetValuePin->PinToolTip = LOCTEXT( "SetValuePin_ToolTip", "Writes New Value into the current pair in place, without rehashing the map." ).ToString();
+		SetValuePin->bAdvancedView = true;
+	}
+
+	// INPUT: New Value
+	UEdGraphPin* NewValuePin =
+		CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, ForEachMap_PinNames::NewValuePin);
+	if (ensure(NewValuePin))
+	{
+		NewValuePin->PinFriendlyName = LOCTEXT( "NewValuePin_FriendlyName", "New Value" );
+		NewValuePin->bAdvancedView = true;
+	}
+
 	// OUTPUT: Loop Body
 	UEdGraphPin* LoopBodyPin =
 		CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then);
@@ -118,6 +168,15 @@ void UK2Node_ForEachMap::AllocateDefaultPins()
 		IndexPin->PinFriendlyName = FText::FromString(IndexName);
 	}
 
+	// OUTPUT: Value Set Exec
+	UEdGraphPin* ValueSetPin =
+		CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, ForEachMap_PinNames::ValueSetPin);
+	if (ensure(ValueSetPin))
+	{
+		ValueSetPin->PinFriendlyName = LOCTEXT( "ValueSetPin_FriendlyName", "Value Set" );
+		ValueSetPin->bAdvancedView = true;
+	}
+
 	// OUTPUT: Completed Exec
 	UEdGraphPin* CompletedPin =
 		CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, ForEachMap_PinNames::CompletePin);
@@ -130,7 +189,7 @@ void UK2Node_ForEachMap::AllocateDefaultPins()
 	{
 		MapPin->PinType = CachedInputType;
 		KeyPin->PinType = CachedKeyType;
-		ValuePin->PinType = CachedValueType;
+		ValuePin->PinType = NewValuePin->PinType = CachedValueType;
 	}
 	else
 	{
@@ -143,6 +202,11 @@ void UK2Node_ForEachMap::AllocateDefaultPins()
 
 		bAutoAssignPins = true; // We've assigned the pins, so next time we load auto assign them
 	}
+
+	if (AdvancedPinDisplay == ENodeAdvancedPins::NoPins)
+	{
+		AdvancedPinDisplay = ENodeAdvancedPins::Hidden;
+	}
 }
 
 void UK2Node_ForEachMap::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
@@ -155,73 +219,101 @@ void UK2Node_ForEachMap::ExpandNode(FKismetCompilerContext& CompilerContext, UEd
 		return;
 	}
 
-	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>( );
-	
 	UEdGraphPin* ForEach_Exec = GetExecPin();
 	UEdGraphPin* ForEach_Map = GetInputMapPin();
 	UEdGraphPin* ForEach_Break = GetInputBreakPin();
+	UEdGraphPin* ForEach_Remove = GetInputRemovePin();
+	UEdGraphPin* ForEach_SetValue = GetInputSetValuePin();
+	UEdGraphPin* ForEach_NewValue = GetInputNewValuePin();
 	UEdGraphPin* ForEach_ForEach = GetLoopBodyPin();
 	UEdGraphPin* ForEach_Key = GetKeyPin();
 	UEdGraphPin* ForEach_Value = GetValuePin();
+	UEdGraphPin* ForEach_ValueSet = GetValueSetPin();
 	UEdGraphPin* ForEach_Completed = GetCompletePin();
 	UEdGraphPin* ForEach_Index = GetIndexPin();
 
 	
-	// Create the getter node
-	UK2Node_CallFunction* CallFunc_GetKeys = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
-	CallFunc_GetKeys->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UBlueprintMapLibrary, Map_Keys ), UBlueprintMapLibrary::StaticClass( ) );
-	CallFunc_GetKeys->AllocateDefaultPins( );
-
-	UEdGraphPin* Get_Exec = CallFunc_GetKeys->GetExecPin();
-	UEdGraphPin* Get_Map = CallFunc_GetKeys->FindPinChecked(TEXT("TargetMap"));
-	UEdGraphPin* Get_Return = CallFunc_GetKeys->FindPinChecked(TEXT("Keys"));
-	UEdGraphPin* Get_Then = CallFunc_GetKeys->GetThenPin();
-
-	CompilerContext.CopyPinLinksToIntermediate( *ForEach_Map, *Get_Map );
-	CallFunc_GetKeys->PinConnectionListChanged(Get_Map);
-
-	CompilerContext.MovePinLinksToIntermediate(*ForEach_Exec, *Get_Exec);
+	// A map made out of literals right here doesn't need to exist at all, as long as nothing has to look at it
+	const bool bCanUnroll = LoopMode == EForEachLoopMode::Immediate && Order == EForEachOrder::Unordered && !bRanged && !bReverse &&
+		ForEach_Remove->LinkedTo.Num() == 0 && ForEach_SetValue->LinkedTo.Num() == 0;
+	if (bCanUnroll)
+	{
+		ForEachMapNodeHelpers::FUnrollPins UnrollPins;
+		UnrollPins.Exec = ForEach_Exec;
+		UnrollPins.Container = ForEach_Map;
+		UnrollPins.Break = ForEach_Break;
+		UnrollPins.LoopBody = ForEach_ForEach;
+		UnrollPins.Key = ForEach_Key;
+		UnrollPins.Value = ForEach_Value;
+		UnrollPins.Index = ForEach_Index;
+		UnrollPins.Completed = ForEach_Completed;
+
+		if (ForEachMapNodeHelpers::TryUnrollLiteralLoop(CompilerContext, this, SourceGraph, UnrollPins))
+		{
+			BreakAllNodeLinks();
+			return;
+		}
+	}
 
-	
-	// Create the internal iterator node
-	UK2Node_InternalIterate* InternalIterate = CompilerContext.SpawnIntermediateNode<UK2Node_InternalIterate>( this, SourceGraph );
+	// Create the internal iterator node, walks the sparse storage of the map in place
+	UK2Node_InternalIterateSparse* InternalIterate = CompilerContext.SpawnIntermediateNode<UK2Node_InternalIterateSparse>( this, SourceGraph );
+	InternalIterate->LoopMode = LoopMode;
+	InternalIterate->bMutationSafe = bMutationSafe;
+	InternalIterate->Order = Order;
+	InternalIterate->TopK = TopK;
+	InternalIterate->bRanged = bRanged;
+	InternalIterate->bReverse = bReverse;
 	InternalIterate->AllocateDefaultPins();
 
 	UEdGraphPin* Internal_Exec = InternalIterate->GetExecPin();
-	UEdGraphPin* Internal_Array = InternalIterate->GetArrayPin();
-	UEdGraphPin* Internal_Index = InternalIterate->GetArrayIndexPin();
+	UEdGraphPin* Internal_Map = InternalIterate->GetContainerPin();
+	UEdGraphPin* Internal_Index = InternalIterate->GetIndexPin();
 	UEdGraphPin* Internal_Break = InternalIterate->GetBreakPin();
+	UEdGraphPin* Internal_Remove = InternalIterate->GetRemovePin();
+	UEdGraphPin* Internal_SetValue = InternalIterate->GetSetValuePin();
+	UEdGraphPin* Internal_NewValue = InternalIterate->GetNewValuePin();
 	UEdGraphPin* Internal_ForEach = InternalIterate->GetForEachPin();
-	UEdGraphPin* Internal_Element = InternalIterate->GetElementPin();
+	UEdGraphPin* Internal_Key = InternalIterate->GetKeyPin();
+	UEdGraphPin* Internal_Value = InternalIterate->GetValuePin();
+	UEdGraphPin* Internal_ValueSet = InternalIterate->GetValueSetPin();
 	UEdGraphPin* Internal_Completed = InternalIterate->GetCompletedPin();
 
-	// All the exec pins wire up directly
-	CompilerContext.MovePinLinksToIntermediate(*ForEach_ForEach, *Internal_ForEach);
-	CompilerContext.MovePinLinksToIntermediate(*ForEach_Break, *Internal_Break);
-	CompilerContext.MovePinLinksToIntermediate(*ForEach_Completed, *Internal_Completed);
+	// Our pins are already resolved, hand the types over
+	Internal_Map->PinType = ForEach_Map->PinType;
+	Internal_Key->PinType = ForEach_Key->PinType;
+	Internal_Value->PinType = Internal_NewValue->PinType = ForEach_Value->PinType;
 
-	Get_Then->MakeLinkTo(Internal_Exec);
-	Schema->TryCreateConnection(Get_Return, Internal_Array);
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_Map, *Internal_Map);
 
-	// For each element is the key, wire up directly
-	CompilerContext.MovePinLinksToIntermediate( *ForEach_Key, *Internal_Element);
-	CompilerContext.MovePinLinksToIntermediate(*ForEach_Index, *Internal_Index);
+	if (LoopMode == EForEachLoopMode::TimeSliced)
+	{
+		ForEachMapNodeHelpers::MoveTimeSlicePinsToIntermediate(CompilerContext, this, InternalIterate);
+	}
 
-	// Create the find node
-	UK2Node_CallFunction* CallFunc_Find = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-	CallFunc_Find->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UBlueprintMapLibrary, Map_Find), UBlueprintMapLibrary::StaticClass());
-	CallFunc_Find->AllocateDefaultPins();
+	if (LoopMode == EForEachLoopMode::Awaitable)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*ForEachMapNodeHelpers::GetContinuePin(this), *ForEachMapNodeHelpers::GetContinuePin(InternalIterate));
+	}
 
-	UEdGraphPin* Find_Map = CallFunc_Find->FindPinChecked(TEXT("TargetMap"));
-	UEdGraphPin* Find_Key = CallFunc_Find->FindPinChecked(TEXT("Key"));
-	UEdGraphPin* Find_Return = CallFunc_Find->FindPinChecked(TEXT("Value"));
+	if (bRanged)
+	{
+		ForEachMapNodeHelpers::MoveRangePinsToIntermediate(CompilerContext, this, InternalIterate);
+	}
 
-	CompilerContext.MovePinLinksToIntermediate(*ForEach_Map,*Find_Map);
-	CallFunc_Find->PinConnectionListChanged(Find_Map);
+	// All the exec pins wire up directly
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_Exec, *Internal_Exec);
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_ForEach, *Internal_ForEach);
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_Break, *Internal_Break);
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_Remove, *Internal_Remove);
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_SetValue, *Internal_SetValue);
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_ValueSet, *Internal_ValueSet);
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_Completed, *Internal_Completed);
 
-	Schema->TryCreateConnection(Internal_Element,Find_Key);
-	
-	CompilerContext.MovePinLinksToIntermediate(*ForEach_Value,*Find_Return);
+	// No more intermediate nodes, the value is read straight from the pair rather than through a Map_Find
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_Key, *Internal_Key);
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_Value, *Internal_Value);
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_NewValue, *Internal_NewValue);
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_Index, *Internal_Index);
 
 	// Break the links as our internal iterator node will handle the rest
 	BreakAllNodeLinks();
@@ -229,12 +321,24 @@ void UK2Node_ForEachMap::ExpandNode(FKismetCompilerContext& CompilerContext, UEd
 
 FText UK2Node_ForEachMap::GetNodeTitle(ENodeTitleType::Type TitleType) const
 {
-	return LOCTEXT("NodeTitle", "For Each Map");
+	if (LoopMode == EForEachLoopMode::TimeSliced)
+	{
+		return LOCTEXT("NodeTitle_TimeSliced", "For Each Map (Time Sliced)");
+	}
+
+	if (LoopMode == EForEachLoopMode::Awaitable)
+	{
+		return LOCTEXT("NodeTitle_Awaitable", "For Each Map (Awaitable)");
+	}
+
+	// Only immediate loops get traced, and so counted
+	return ForEachMapNodeHelpers::AppendLoopStats(this, TitleType, LOCTEXT("NodeTitle", "For Each Map"));
 }
 
 FText UK2Node_ForEachMap::GetTooltipText() const
 {
-	return LOCTEXT("NodeTooltip", "Fuck it, just give up.");
+	return LOCTEXT("NodeTooltip", "Loops over every pair of the map, in place.\n"
+		"Pairs the loop body adds are left out, unless they land in a slot the body freed ahead of the loop. Tick Mutation Safe if the body changes the map.");
 }
 
 FText UK2Node_ForEachMap::GetKeywords() const
@@ -251,7 +355,7 @@ FSlateIcon UK2Node_ForEachMap::GetIconAndTint(FLinearColor& OutColor) const
 
 FLinearColor UK2Node_ForEachMap::GetNodeTitleColor() const
 {
-	return FLinearColor::White;
+	return ForEachMapNodeHelpers::GetLoopHeatColor(this, FLinearColor::White);
 }
 
 void UK2Node_ForEachMap::PinConnectionListChanged(UEdGraphPin* Pin)
@@ -264,23 +368,26 @@ void UK2Node_ForEachMap::PinConnectionListChanged(UEdGraphPin* Pin)
 	}
 
 	if (Pin->PinName == ForEachMap_PinNames::KeyPin ||
-		Pin->PinName == ForEachMap_PinNames::ValuePin)
+		Pin->PinName == ForEachMap_PinNames::ValuePin ||
+		Pin->PinName == ForEachMap_PinNames::NewValuePin)
 	{
 		UEdGraphPin* ValuePin = GetValuePin();
+		UEdGraphPin* NewValuePin = GetInputNewValuePin();
 		UEdGraphPin* KeyPin = GetKeyPin();
 		UEdGraphPin* MapPin = GetInputMapPin();
 
 		// If we're connected to nothing, reset all those pin types
-		if ( (ValuePin->LinkedTo.Num() + KeyPin->LinkedTo.Num() + MapPin->LinkedTo.Num()) <= 0)
+		if ( (ValuePin->LinkedTo.Num() + NewValuePin->LinkedTo.Num() + KeyPin->LinkedTo.Num() + MapPin->LinkedTo.Num()) <= 0)
 		{
 			MapPin->PinType = CachedInputWildcardType;
-			KeyPin->PinType = ValuePin->PinType = CachedWildcardType;
+			KeyPin->PinType = ValuePin->PinType = NewValuePin->PinType = CachedWildcardType;
 		}
 	}
 
 	if (Pin->PinName == ForEachMap_PinNames::MapPin)
 	{
 		UEdGraphPin* ValuePin = GetValuePin();
+		UEdGraphPin* NewValuePin = GetInputNewValuePin();
 		UEdGraphPin* KeyPin = GetKeyPin();
 
 		bool bShouldReconnect = false;
@@ -294,14 +401,15 @@ void UK2Node_ForEachMap::PinConnectionListChanged(UEdGraphPin* Pin)
 			Pin->PinType = FirstPin->PinType;
 			KeyPin->PinType = FEdGraphPinType::GetTerminalTypeForContainer(FirstPin->PinType);
 			ValuePin->PinType = FEdGraphPinType::GetPinTypeForTerminalType(FirstPin->PinType.PinValueType);
+			NewValuePin->PinType = ValuePin->PinType;
 		}
 		else
 		{
 			// If we have no connections anymore, reset pin types
-			if (ValuePin->LinkedTo.Num() + KeyPin->LinkedTo.Num() <= 0)
+			if (ValuePin->LinkedTo.Num() + NewValuePin->LinkedTo.Num() + KeyPin->LinkedTo.Num() <= 0)
 			{
 				Pin->PinType = CachedInputWildcardType;
-				KeyPin->PinType = ValuePin->PinType = CachedWildcardType;
+				KeyPin->PinType = ValuePin->PinType = NewValuePin->PinType = CachedWildcardType;
 				bShouldReconnect = true;
 			}
 		}
@@ -310,25 +418,11 @@ void UK2Node_ForEachMap::PinConnectionListChanged(UEdGraphPin* Pin)
 		CachedKeyType = KeyPin->PinType;
 		CachedValueType = ValuePin->PinType;
 
-		auto ReconnectPins = [this](UEdGraphPin* Pin)
-		{
-			TArray<UEdGraphPin*>& LinkedPins = Pin->LinkedTo;
-			Pin->BreakAllPinLinks(true);
-
-			const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
-			for (UEdGraphPin* Connection : LinkedPins)
-			{
-				Schema->TryCreateConnection( Pin, Connection);
-			}
-
-			GetGraph()->NotifyGraphChanged();
-			FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
-		};
-
 		if (bShouldReconnect)
 		{
-			ReconnectPins(KeyPin);
-			ReconnectPins(ValuePin);	
+			ForEachMapNodeHelpers::ReconnectPins(this, KeyPin);
+			ForEachMapNodeHelpers::ReconnectPins(this, ValuePin);
+			ForEachMapNodeHelpers::ReconnectPins(this, NewValuePin);
 		}
 	}
 }
@@ -356,7 +450,19 @@ void UK2Node_ForEachMap::PostEditChangeProperty(FPropertyChangedEvent& PropertyC
 
 	bool bRefresh = false;
 
-	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, KeyName))
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, LoopMode))
+	{
+		// Budget and Continue pins come and go with the loop mode
+		ReconstructNode();
+		bRefresh = true;
+	}
+	else if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, bRanged))
+	{
+		// So do the range pins
+		ReconstructNode();
+		bRefresh = true;
+	}
+	else if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, KeyName))
 	{
 		GetKeyPin()->PinFriendlyName = FText::FromString(KeyName);
 		bRefresh = true;
@@ -391,6 +497,21 @@ UEdGraphPin* UK2Node_ForEachMap::GetInputBreakPin() const
 	return FindPinChecked(ForEachMap_PinNames::BreakPin);
 }
 
+UEdGraphPin* UK2Node_ForEachMap::GetInputRemovePin() const
+{
+	return FindPinChecked(ForEachMap_PinNames::RemovePin);
+}
+
+UEdGraphPin* UK2Node_ForEachMap::GetInputSetValuePin() const
+{
+	return FindPinChecked(ForEachMap_PinNames::SetValuePin);
+}
+
+UEdGraphPin* UK2Node_ForEachMap::GetInputNewValuePin() const
+{
+	return FindPinChecked(ForEachMap_PinNames::NewValuePin);
+}
+
 UEdGraphPin* UK2Node_ForEachMap::GetLoopBodyPin() const
 {
 	return FindPinChecked(UEdGraphSchema_K2::PN_Then);
@@ -406,6 +527,11 @@ UEdGraphPin* UK2Node_ForEachMap::GetValuePin() const
 	return FindPinChecked(ForEachMap_PinNames::ValuePin);
 }
 
+UEdGraphPin* UK2Node_ForEachMap::GetValueSetPin() const
+{
+	return FindPinChecked(ForEachMap_PinNames::ValueSetPin);
+}
+
 UEdGraphPin* UK2Node_ForEachMap::GetCompletePin() const
 {
 	return FindPinChecked(ForEachMap_PinNames::CompletePin);
@@ -426,7 +552,43 @@ bool UK2Node_ForEachMap::CheckForErrors(const FKismetCompilerContext& CompilerCo
 		return true;
 	}
 
-	return false;
+	// Removing from a temporary copy would go unnoticed
+	if (GetInputRemovePin()->LinkedTo.Num() > 0 && ForEachMapNodeHelpers::IsReevaluatedPerRead(GetInputMapPin()))
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT( "RemoveFromTemporary", "Remove Current of @@ needs a map variable to remove from, the input is a temporary copy.").ToString(),
+			this);
+		return true;
+	}
+
+	// Same goes for writing values into it
+	if (GetInputSetValuePin()->LinkedTo.Num() > 0 && ForEachMapNodeHelpers::IsReevaluatedPerRead(GetInputMapPin()))
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT( "SetValueOnTemporary", "Set Current Value of @@ needs a map variable to write into, the input is a temporary copy.").ToString(),
+			this);
+		return true;
+	}
+
+	// Ordered loops follow the sparse indices sorted on entry, an entry the body adds into a freed slot would still be visited
+	if (bMutationSafe && Order != EForEachOrder::Unordered)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT( "OrderedMutationSafe", "@@ can't be Mutation Safe and ordered at once.").ToString(),
+			this);
+		return true;
+	}
+
+	if (bMutationSafe && (bRanged || bReverse))
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT( "RangedMutationSafe", "@@ can't be Mutation Safe and ranged or reversed at once.").ToString(),
+			this);
+		return true;
+	}
+
+	return ForEachMapNodeHelpers::CheckLoopModeForErrors(CompilerContext, this, LoopMode) ||
+		ForEachMapNodeHelpers::CheckOrderForErrors(CompilerContext, this, Order, GetKeyPin()->PinType, &GetValuePin()->PinType);
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ForEachLoopTypes.h"
 #include "K2Node.h"
 #include "K2Node_ForEachMap.generated.h"
 
@@ -41,9 +42,13 @@ public:
 	/** Pin Accessors */
 	[[nodiscard]] UEdGraphPin* GetInputMapPin() const;
 	[[nodiscard]] UEdGraphPin* GetInputBreakPin() const;
+	[[nodiscard]] UEdGraphPin* GetInputRemovePin() const;
+	[[nodiscard]] UEdGraphPin* GetInputSetValuePin() const;
+	[[nodiscard]] UEdGraphPin* GetInputNewValuePin() const;
 	[[nodiscard]] UEdGraphPin* GetLoopBodyPin() const;
 	[[nodiscard]] UEdGraphPin* GetKeyPin() const;
 	[[nodiscard]] UEdGraphPin* GetValuePin() const;
+	[[nodiscard]] UEdGraphPin* GetValueSetPin() const;
 	[[nodiscard]] UEdGraphPin* GetCompletePin() const;
 	[[nodiscard]] UEdGraphPin* GetIndexPin() const;
 
@@ -68,6 +73,38 @@ protected:
 	bool bAutoAssignPins = false;
 
 private:
+	/** Whether the loop runs right away, is spread across frames within a budget, or waits for Continue between entries */
+	UPROPERTY(EditDefaultsOnly, Category = ForEachMap)
+	EForEachLoopMode LoopMode = EForEachLoopMode::Immediate;
+
+	/**
+	 * Makes it safe for the loop body to add or remove pairs. The loop keeps walking the live storage and only checks the count per step,
+	 * a snapshot of the pairs still ahead is only made once the body actually changed something. Can't be combined with Order,
+	 * ordered loops follow the slots sorted on entry and would visit pairs added into the slots the body freed.
+	 * Pairs added past the end the storage had on entry are never visited, but a pair added after removing one ahead of the loop
+	 * reuses the freed slot and is visited.
+	 * Changes are told by the count and the end of the storage only: removing a pair (other than through Remove Current) and adding
+	 * one within the same iteration goes unnoticed, and the added pair may still be visited
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = ForEachMap, meta = (DisplayName = "Mutation Safe"))
+	bool bMutationSafe = false;
+
+	/** Walks the pairs sorted by key or by value rather than in storage order, at the cost of a sort on loop entry */
+	UPROPERTY(EditDefaultsOnly, Category = ForEachMap, meta = (DisplayName = "Order"))
+	EForEachOrder Order = EForEachOrder::Unordered;
+
+	/** Only walks the first K entries of the order, zero walks all of them. Sorts partially in O(n log k) when set */
+	UPROPERTY(EditDefaultsOnly, Category = ForEachMap, meta = (DisplayName = "Top K", ClampMin = 0, EditCondition = "Order != EForEachOrder::Unordered"))
+	int32 TopK = 0;
+
+	/** Adds Start, Count and Stride pins, to only visit a window of the pairs or every Nth one */
+	UPROPERTY(EditDefaultsOnly, Category = ForEachMap, meta = (DisplayName = "Range"))
+	bool bRanged = false;
+
+	/** Walks the pairs back to front, a range counts from the back as well */
+	UPROPERTY(EditDefaultsOnly, Category = ForEachMap, meta = (DisplayName = "Reverse"))
+	bool bReverse = false;
+
 	/** A user-editable hook for the display name of the key pin */
 	UPROPERTY(EditDefaultsOnly, Category = ForEachMap)
 	FString KeyName;
@@ -5,11 +5,9 @@
 
 #include "BlueprintActionDatabaseRegistrar.h"
 #include "BlueprintNodeSpawner.h"
-#include "K2Node_CallFunction.h"
-#include "K2Node_InternalIterate.h"
+#include "ForEachMapNodeHelpers.h"
+#include "K2Node_InternalIterateSparse.h"
 #include "KismetCompiler.h"
-#include "Kismet/BlueprintMapLibrary.h"
-#include "Kismet/BlueprintSetLibrary.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 
 
@@ -21,6 +19,7 @@ namespace ForEachSet_PinNames
 {
 	static const FName SetPin(TEXT("SetPin"));
 	static const FName BreakPin(TEXT("BreakPin"));
+	static const FName RemovePin(TEXT("RemovePin"));
 	static const FName ValuePin(TEXT("ValuePin"));
 	static const FName CompletePin(TEXT("CompletePin"));
 	static const FName IndexPin(TEXT("IndexPin"));
@@ -86,6 +85,33 @@ void UK2Node_ForEachSet::AllocateDefaultPins()
 		BreakPin->PinFriendlyName = LOCTEXT( "BreakPin_FriendlyName", "Break" );
 	}
 
+	// INPUT: Remove Current, takes the current element out and carries on with the next one
+	UEdGraphPin* RemovePin =
+		CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, ForEachSet_PinNames::RemovePin);
+	if (ensure(RemovePin))
+	{
+		RemovePin->PinFriendlyName = LOCTEXT( "RemovePin_FriendlyName", "Remove Current" );
+		RemovePin->PinToolTip = LOCTEXT( "RemovePin_ToolTip", "Removes the current element in place, the loop carries on with the next one." ).ToString();
+	}
+
+	// INPUT: Per-frame budget, time-sliced loops only
+	if (LoopMode == EForEachLoopMode::TimeSliced)
+	{
+		ForEachMapNodeHelpers::CreateTimeSlicePins(this);
+	}
+
+	// INPUT: Continue, awaitable loops only
+	if (LoopMode == EForEachLoopMode::Awaitable)
+	{
+		ForEachMapNodeHelpers::CreateContinuePin(this);
+	}
+
+	// INPUT: Start, Count and Stride, ranged loops only
+	if (bRanged)
+	{
+		ForEachMapNodeHelpers::CreateRangePins(this);
+	}
+
 	// OUTPUT: Loop Body
 	UEdGraphPin* LoopBodyPin =
 		CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then);
@@ -145,52 +171,85 @@ void UK2Node_ForEachSet::ExpandNode(class FKismetCompilerContext& CompilerContex
 		return;
 	}
 
-	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>( );
-
 	// This node
 	UEdGraphPin* ForEach_Exec = GetExecPin();
 	UEdGraphPin* ForEach_Set = GetInputSetPin();
 	UEdGraphPin* ForEach_Break = GetInputBreakPin();
+	UEdGraphPin* ForEach_Remove = GetInputRemovePin();
 	UEdGraphPin* ForEach_ForEach = GetLoopBodyPin();
 	UEdGraphPin* ForEach_Value = GetValuePin();
 	UEdGraphPin* ForEach_Completed = GetCompletePin();
 	UEdGraphPin* ForEach_Index = GetIndexPin();
 
-	// Create the getter node
-	UK2Node_CallFunction* CallFunc_ToArray = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
-	CallFunc_ToArray->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UBlueprintSetLibrary, Set_ToArray ), UBlueprintMapLibrary::StaticClass( ) );
-	CallFunc_ToArray->AllocateDefaultPins( );
-	UEdGraphPin* ToArray_Exec = CallFunc_ToArray->GetExecPin();
-	UEdGraphPin* ToArray_Set = CallFunc_ToArray->FindPinChecked(TEXT("A"));
-	UEdGraphPin* ToArray_Return = CallFunc_ToArray->FindPinChecked(TEXT("Result"));
-	UEdGraphPin* ToArray_Then = CallFunc_ToArray->GetThenPin();
-
-	CompilerContext.CopyPinLinksToIntermediate( *ForEach_Set, *ToArray_Set );
-	CallFunc_ToArray->PinConnectionListChanged(ToArray_Set);
-
-	CompilerContext.MovePinLinksToIntermediate(*ForEach_Exec, *ToArray_Exec);
-
+	// A set made out of literals right here doesn't need to exist at all, as long as nothing has to look at it
+	const bool bCanUnroll = LoopMode == EForEachLoopMode::Immediate && Order == EForEachOrder::Unordered && !bRanged && !bReverse &&
+		ForEach_Remove->LinkedTo.Num() == 0;
+	if (bCanUnroll)
+	{
+		ForEachMapNodeHelpers::FUnrollPins UnrollPins;
+		UnrollPins.Exec = ForEach_Exec;
+		UnrollPins.Container = ForEach_Set;
+		UnrollPins.Break = ForEach_Break;
+		UnrollPins.LoopBody = ForEach_ForEach;
+		UnrollPins.Key = ForEach_Value;
+		UnrollPins.Index = ForEach_Index;
+		UnrollPins.Completed = ForEach_Completed;
+
+		if (ForEachMapNodeHelpers::TryUnrollLiteralLoop(CompilerContext, this, SourceGraph, UnrollPins))
+		{
+			BreakAllNodeLinks();
+			return;
+		}
+	}
 
-	// Create the internal iterator node
-	UK2Node_InternalIterate* InternalIterate = CompilerContext.SpawnIntermediateNode<UK2Node_InternalIterate>( this, SourceGraph );
+	// Create the internal iterator node, walks the sparse storage of the set in place
+	UK2Node_InternalIterateSparse* InternalIterate = CompilerContext.SpawnIntermediateNode<UK2Node_InternalIterateSparse>( this, SourceGraph );
+	InternalIterate->ContainerType = EPinContainerType::Set;
+	InternalIterate->LoopMode = LoopMode;
+	InternalIterate->bMutationSafe = bMutationSafe;
+	InternalIterate->Order = Order;
+	InternalIterate->TopK = TopK;
+	InternalIterate->bRanged = bRanged;
+	InternalIterate->bReverse = bReverse;
 	InternalIterate->AllocateDefaultPins();
 
 	UEdGraphPin* Internal_Exec = InternalIterate->GetExecPin();
-	UEdGraphPin* Internal_Array = InternalIterate->GetArrayPin();
-	UEdGraphPin* Internal_Index = InternalIterate->GetArrayIndexPin();
+	UEdGraphPin* Internal_Set = InternalIterate->GetContainerPin();
+	UEdGraphPin* Internal_Index = InternalIterate->GetIndexPin();
 	UEdGraphPin* Internal_Break = InternalIterate->GetBreakPin();
+	UEdGraphPin* Internal_Remove = InternalIterate->GetRemovePin();
 	UEdGraphPin* Internal_ForEach = InternalIterate->GetForEachPin();
-	UEdGraphPin* Internal_Element = InternalIterate->GetElementPin();
+	UEdGraphPin* Internal_Element = InternalIterate->GetKeyPin();
 	UEdGraphPin* Internal_Completed = InternalIterate->GetCompletedPin();
 
+	// Our pins are already resolved, hand the types over
+	Internal_Set->PinType = ForEach_Set->PinType;
+	Internal_Element->PinType = ForEach_Value->PinType;
+
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_Set, *Internal_Set);
+
+	if (LoopMode == EForEachLoopMode::TimeSliced)
+	{
+		ForEachMapNodeHelpers::MoveTimeSlicePinsToIntermediate(CompilerContext, this, InternalIterate);
+	}
+
+	if (LoopMode == EForEachLoopMode::Awaitable)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*ForEachMapNodeHelpers::GetContinuePin(this), *ForEachMapNodeHelpers::GetContinuePin(InternalIterate));
+	}
+
+	if (bRanged)
+	{
+		ForEachMapNodeHelpers::MoveRangePinsToIntermediate(CompilerContext, this, InternalIterate);
+	}
+
 	// All the exec pins wire up directly
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_Exec, *Internal_Exec);
 	CompilerContext.MovePinLinksToIntermediate(*ForEach_ForEach, *Internal_ForEach);
 	CompilerContext.MovePinLinksToIntermediate(*ForEach_Break, *Internal_Break);
+	CompilerContext.MovePinLinksToIntermediate(*ForEach_Remove, *Internal_Remove);
 	CompilerContext.MovePinLinksToIntermediate(*ForEach_Completed, *Internal_Completed);
 
-	ToArray_Then->MakeLinkTo(Internal_Exec);
-	Schema->TryCreateConnection(ToArray_Return, Internal_Array);
-
 	// No more intermediate nodes, just wire up directly
 	CompilerContext.MovePinLinksToIntermediate(*ForEach_Value, *Internal_Element);
 	CompilerContext.MovePinLinksToIntermediate(*ForEach_Index, *Internal_Index);
@@ -201,12 +260,24 @@ void UK2Node_ForEachSet::ExpandNode(class FKismetCompilerContext& CompilerContex
 
 FText UK2Node_ForEachSet::GetNodeTitle(ENodeTitleType::Type TitleType) const
 {
-	return LOCTEXT("NodeTitle", "For Each Set");
+	if (LoopMode == EForEachLoopMode::TimeSliced)
+	{
+		return LOCTEXT("NodeTitle_TimeSliced", "For Each Set (Time Sliced)");
+	}
+
+	if (LoopMode == EForEachLoopMode::Awaitable)
+	{
+		return LOCTEXT("NodeTitle_Awaitable", "For Each Set (Awaitable)");
+	}
+
+	// Only immediate loops get traced, and so counted
+	return ForEachMapNodeHelpers::AppendLoopStats(this, TitleType, LOCTEXT("NodeTitle", "For Each Set"));
 }
 
 FText UK2Node_ForEachSet::GetTooltipText() const
 {
-	return LOCTEXT("NodeTooltip", "Fuck it, just give up.");
+	return LOCTEXT("NodeTooltip", "Loops over every element of the set, in place.\n"
+		"Elements the loop body adds are left out, unless they land in a slot the body freed ahead of the loop. Tick Mutation Safe if the body changes the set.");
 }
 
 FText UK2Node_ForEachSet::GetKeywords() const
@@ -223,7 +294,7 @@ FSlateIcon UK2Node_ForEachSet::GetIconAndTint(FLinearColor& OutColor) const
 
 FLinearColor UK2Node_ForEachSet::GetNodeTitleColor() const
 {
-	return FLinearColor::White;
+	return ForEachMapNodeHelpers::GetLoopHeatColor(this, FLinearColor::White);
 }
 
 void UK2Node_ForEachSet::PinConnectionListChanged(UEdGraphPin* Pin)
@@ -277,24 +348,9 @@ void UK2Node_ForEachSet::PinConnectionListChanged(UEdGraphPin* Pin)
 		CachedInputType = Pin->PinType;
 		CachedValueType = ValuePin->PinType;
 
-		auto ReconnectPins = [this](UEdGraphPin* Pin)
-		{
-			TArray<UEdGraphPin*>& LinkedPins = Pin->LinkedTo;
-			Pin->BreakAllPinLinks(true);
-
-			const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
-			for (UEdGraphPin* Connection : LinkedPins)
-			{
-				Schema->TryCreateConnection( Pin, Connection);
-			}
-
-			GetGraph()->NotifyGraphChanged();
-			FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
-		};
-
 		if (bShouldReconnect)
 		{
-			ReconnectPins(ValuePin);	
+			ForEachMapNodeHelpers::ReconnectPins(this, ValuePin);	
 		}
 	}
 }
@@ -322,7 +378,19 @@ void UK2Node_ForEachSet::PostEditChangeProperty(FPropertyChangedEvent& PropertyC
 
 	bool bRefresh = false;
 
-	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, ValueName))
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, LoopMode))
+	{
+		// Budget and Continue pins come and go with the loop mode
+		ReconstructNode();
+		bRefresh = true;
+	}
+	else if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, bRanged))
+	{
+		// So do the range pins
+		ReconstructNode();
+		bRefresh = true;
+	}
+	else if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, ValueName))
 	{
 		GetValuePin()->PinFriendlyName = FText::FromString(ValueName);
 		bRefresh = true;
@@ -351,6 +419,11 @@ UEdGraphPin* UK2Node_ForEachSet::GetInputBreakPin() const
 	return FindPinChecked(ForEachSet_PinNames::BreakPin);
 }
 
+UEdGraphPin* UK2Node_ForEachSet::GetInputRemovePin() const
+{
+	return FindPinChecked(ForEachSet_PinNames::RemovePin);
+}
+
 UEdGraphPin* UK2Node_ForEachSet::GetLoopBodyPin() const
 {
 	return FindPinChecked(UEdGraphSchema_K2::PN_Then);
@@ -381,7 +454,34 @@ bool UK2Node_ForEachSet::CheckForErrors(const FKismetCompilerContext& CompilerCo
 		return true;
 	}
 
-	return false;
+	// Removing from a temporary copy would go unnoticed
+	if (GetInputRemovePin()->LinkedTo.Num() > 0 && ForEachMapNodeHelpers::IsReevaluatedPerRead(GetInputSetPin()))
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT( "RemoveFromTemporary", "Remove Current of @@ needs a set variable to remove from, the input is a temporary copy.").ToString(),
+			this);
+		return true;
+	}
+
+	// Ordered loops follow the sparse indices sorted on entry, an entry the body adds into a freed slot would still be visited
+	if (bMutationSafe && Order != EForEachOrder::Unordered)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT( "OrderedMutationSafe", "@@ can't be Mutation Safe and ordered at once.").ToString(),
+			this);
+		return true;
+	}
+
+	if (bMutationSafe && (bRanged || bReverse))
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT( "RangedMutationSafe", "@@ can't be Mutation Safe and ranged or reversed at once.").ToString(),
+			this);
+		return true;
+	}
+
+	return ForEachMapNodeHelpers::CheckLoopModeForErrors(CompilerContext, this, LoopMode) ||
+		ForEachMapNodeHelpers::CheckOrderForErrors(CompilerContext, this, Order, GetValuePin()->PinType, nullptr);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
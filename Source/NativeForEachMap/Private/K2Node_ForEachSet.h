@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ForEachLoopTypes.h"
 #include "K2Node.h"
 #include "K2Node_ForEachSet.generated.h"
 
@@ -41,6 +42,7 @@ public:
 	/** Pin Accessors */
 	[[nodiscard]] UEdGraphPin* GetInputSetPin() const;
 	[[nodiscard]] UEdGraphPin* GetInputBreakPin() const;
+	[[nodiscard]] UEdGraphPin* GetInputRemovePin() const;
 	[[nodiscard]] UEdGraphPin* GetLoopBodyPin() const;
 	[[nodiscard]] UEdGraphPin* GetValuePin() const;
 	[[nodiscard]] UEdGraphPin* GetCompletePin() const;
@@ -65,6 +67,38 @@ protected:
 	bool bAutoAssignPins = false;
 
 private:
+	/** Whether the loop runs right away, is spread across frames within a budget, or waits for Continue between entries */
+	UPROPERTY(EditDefaultsOnly, Category = ForEachSet)
+	EForEachLoopMode LoopMode = EForEachLoopMode::Immediate;
+
+	/**
+	 * Makes it safe for the loop body to add or remove elements. The loop keeps walking the live storage and only checks the count per step,
+	 * a snapshot of the elements still ahead is only made once the body actually changed something. Can't be combined with Order,
+	 * ordered loops follow the slots sorted on entry and would visit elements added into the slots the body freed.
+	 * Elements added past the end the storage had on entry are never visited, but an element added after removing one ahead of the loop
+	 * reuses the freed slot and is visited.
+	 * Changes are told by the count and the end of the storage only: removing an element (other than through Remove Current) and adding
+	 * one within the same iteration goes unnoticed, and the added element may still be visited
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = ForEachSet, meta = (DisplayName = "Mutation Safe"))
+	bool bMutationSafe = false;
+
+	/** Walks the elements sorted rather than in storage order, at the cost of a sort on loop entry */
+	UPROPERTY(EditDefaultsOnly, Category = ForEachSet, meta = (DisplayName = "Order", InvalidEnumValues = "ValueAscending,ValueDescending"))
+	EForEachOrder Order = EForEachOrder::Unordered;
+
+	/** Only walks the first K entries of the order, zero walks all of them. Sorts partially in O(n log k) when set */
+	UPROPERTY(EditDefaultsOnly, Category = ForEachSet, meta = (DisplayName = "Top K", ClampMin = 0, EditCondition = "Order != EForEachOrder::Unordered"))
+	int32 TopK = 0;
+
+	/** Adds Start, Count and Stride pins, to only visit a window of the elements or every Nth one */
+	UPROPERTY(EditDefaultsOnly, Category = ForEachSet, meta = (DisplayName = "Range"))
+	bool bRanged = false;
+
+	/** Walks the elements back to front, a range counts from the back as well */
+	UPROPERTY(EditDefaultsOnly, Category = ForEachSet, meta = (DisplayName = "Reverse"))
+	bool bReverse = false;
+
 	/** A user-editable hook for the display name of the value pin */
 	UPROPERTY(EditDefaultsOnly, Category = ForEachSet)
 	FString ValueName;
@@ -5,14 +5,16 @@
 
 #include "BlueprintActionDatabaseRegistrar.h"
 #include "BlueprintNodeSpawner.h"
+#include "ForEachMapLibrary.h"
+#include "ForEachMapNodeHelpers.h"
 #include "K2Node_AssignmentStatement.h"
 #include "K2Node_CallFunction.h"
 #include "K2Node_ExecutionSequence.h"
 #include "K2Node_IfThenElse.h"
 #include "K2Node_TemporaryVariable.h"
 #include "KismetCompiler.h"
+#include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet/KismetArrayLibrary.h"
-#include "Kismet/KismetMathLibrary.h"
 
 #define LOCTEXT_NAMESPACE "K2Node_NativeForEach"
 
@@ -107,6 +109,18 @@ void UK2Node_InternalIterate::AllocateDefaultPins()
 		BreakPin->PinFriendlyName = LOCTEXT("BreakPin_FriendlyName", "Break");
 	}
 
+	// INPUT: Continue, awaitable loops only
+	if (LoopMode == EForEachLoopMode::Awaitable)
+	{
+		ForEachMapNodeHelpers::CreateContinuePin(this);
+	}
+
+	// INPUT: Start, Count and Stride, ranged loops only
+	if (bRanged)
+	{
+		ForEachMapNodeHelpers::CreateRangePins(this);
+	}
+
 	// OUTPUT: Loop Body
 	UEdGraphPin* LoopBodyPin =
 		CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then);
@@ -175,6 +189,35 @@ void UK2Node_InternalIterate::ExpandNode(FKismetCompilerContext& CompilerContext
 	UEdGraphPin* ArrayIndexPin = GetArrayIndexPin();
 	UEdGraphPin* CompletedPin = GetCompletedPin();
 
+	// An array made out of literals right here doesn't need to exist at all
+	if (LoopMode == EForEachLoopMode::Immediate && !bRanged && !bReverse)
+	{
+		ForEachMapNodeHelpers::FUnrollPins UnrollPins;
+		UnrollPins.Exec = ExecPin;
+		UnrollPins.Container = ArrayPin;
+		UnrollPins.Break = GetBreakPin();
+		UnrollPins.LoopBody = ForEachPin;
+		UnrollPins.Key = ArrayElementPin;
+		UnrollPins.Index = ArrayIndexPin;
+		UnrollPins.Completed = CompletedPin;
+
+		if (ForEachMapNodeHelpers::TryUnrollLiteralLoop(CompilerContext, this, SourceGraph, UnrollPins))
+		{
+			BreakAllNodeLinks();
+			return;
+		}
+	}
+
+	// Frame spanning loops would leave their scope open across frames, only immediate runs get traced
+	if (LoopMode == EForEachLoopMode::Immediate)
+	{
+		ForEachMapNodeHelpers::WrapInTraceScope(CompilerContext, this, SourceGraph, ExecPin, ForEachPin, CompletedPin);
+	}
+
+	// The array is read by the loop condition and by every element fetch,
+	// so a pure source gets evaluated once at loop entry instead of on each of those reads
+	ForEachMapNodeHelpers::CaptureInputOnce(CompilerContext, this, SourceGraph, ExecPin, ArrayPin);
+
 	// Create a local temporary variable
 	UK2Node_TemporaryVariable* TempVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
 	TempVar->VariableType.PinCategory = UEdGraphSchema_K2::PC_Int;
@@ -183,7 +226,7 @@ void UK2Node_InternalIterate::ExpandNode(FKismetCompilerContext& CompilerContext
 	UEdGraphPin* TempVar_Pin = TempVar->GetVariablePin();
 	CompilerContext.MovePinLinksToIntermediate( *ArrayIndexPin, *TempVar_Pin);
 
-	// Default value to 0
+	// Start out in front of the first element, Next moves onto it
 	UK2Node_AssignmentStatement* Init_TempVar = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
 	Init_TempVar->AllocateDefaultPins();
 
@@ -194,47 +237,64 @@ void UK2Node_InternalIterate::ExpandNode(FKismetCompilerContext& CompilerContext
 
 	CompilerContext.MovePinLinksToIntermediate(*ExecPin, *Init_Exec);
 	Schema->TryCreateConnection(Init_Variable, TempVar_Pin);
-	Init_Value->DefaultValue = TEXT("0"); // <-- Nice, initializing to 0 by using a string
-
-	// Create a loop condition branch
-	UK2Node_IfThenElse* BranchCond = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
-	BranchCond->AllocateDefaultPins();
+	Init_Value->DefaultValue = LexToString(INDEX_NONE);
 
-	UEdGraphPin* Branch_Exec = BranchCond->GetExecPin();
-	UEdGraphPin* Branch_Input = BranchCond->GetConditionPin();
-	UEdGraphPin* Branch_Then = BranchCond->GetThenPin();
-	UEdGraphPin* Branch_Else = BranchCond->GetElsePin();
-
-	Init_Then->MakeLinkTo(Branch_Exec);
-	CompilerContext.MovePinLinksToIntermediate(*CompletedPin, *Branch_Else);
+	// Length is taken once at loop entry, the loop condition just compares against that
+	UK2Node_TemporaryVariable* LengthVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+	LengthVar->VariableType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	LengthVar->AllocateDefaultPins();
 
-	// Create the linker node to the loop condition branch
-	UK2Node_CallFunction* LessThanFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-	LessThanFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Less_IntInt), UKismetMathLibrary::StaticClass());
-	LessThanFunc->AllocateDefaultPins();
+	UEdGraphPin* LengthVar_Pin = LengthVar->GetVariablePin();
 
-	UEdGraphPin* Compare_A = LessThanFunc->FindPinChecked(TEXT("A"));
-	UEdGraphPin* Compare_B = LessThanFunc->FindPinChecked(TEXT("B"));
-	UEdGraphPin* Compare_Return = LessThanFunc->GetReturnValuePin();
+	UK2Node_AssignmentStatement* Init_LengthVar = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
+	Init_LengthVar->AllocateDefaultPins();
 
-	Branch_Input->MakeLinkTo(Compare_Return);
-	TempVar_Pin->MakeLinkTo(Compare_A);
+	Init_Then->MakeLinkTo(Init_LengthVar->GetExecPin());
+	Schema->TryCreateConnection(Init_LengthVar->GetVariablePin(), LengthVar_Pin);
 
-	// Create another linker node to get the length of the array
 	UK2Node_CallFunction* ArrayLenFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
 	ArrayLenFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UKismetArrayLibrary, Array_Length), UKismetArrayLibrary::StaticClass());
 	ArrayLenFunc->AllocateDefaultPins();
 
 	UEdGraphPin* ArrayLength_Array = ArrayLenFunc->FindPinChecked(TEXT("TargetArray"));
 	UEdGraphPin* ArrayLength_Return = ArrayLenFunc->GetReturnValuePin();
-	
-	ArrayLength_Array->PinType = ArrayPin->PinType;
 
-	// And connect
-	Compare_B->MakeLinkTo(ArrayLength_Return);
+	ArrayLength_Array->PinType = ArrayPin->PinType;
 	CompilerContext.CopyPinLinksToIntermediate(*ArrayPin,*ArrayLength_Array);
+	ArrayLength_Return->MakeLinkTo(Init_LengthVar->GetValuePin());
+
+	// Next(Index, Length) counts up and tells whether we are still in range, all in one native call.
+	// The ranged variant jumps straight to the next visited index, skipped elements cost nothing
+	const bool bIsRanged = bRanged || bReverse;
+
+	UK2Node_CallFunction* NextFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	NextFunc->FunctionReference.SetExternalMember(
+		bIsRanged ? GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Array_RangedIteratorNext) : GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Array_IteratorNext),
+		UForEachMapLibrary::StaticClass());
+	NextFunc->AllocateDefaultPins();
+
+	if (bIsRanged)
+	{
+		ForEachMapNodeHelpers::ConnectRangedNext(CompilerContext, this, NextFunc, bReverse);
+	}
+
+	UEdGraphPin* Next_Exec = NextFunc->GetExecPin();
+	NextFunc->FindPinChecked(TEXT("Index"))->MakeLinkTo(TempVar_Pin);
+	NextFunc->FindPinChecked(TEXT("Length"))->MakeLinkTo(LengthVar_Pin);
+	Init_LengthVar->GetThenPin()->MakeLinkTo(Next_Exec);
+
+	// Create a loop condition branch
+	UK2Node_IfThenElse* BranchCond = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
+	BranchCond->AllocateDefaultPins();
 
-	// Incrementer node
+	UEdGraphPin* Branch_Then = BranchCond->GetThenPin();
+	UEdGraphPin* Branch_Else = BranchCond->GetElsePin();
+
+	NextFunc->GetThenPin()->MakeLinkTo(BranchCond->GetExecPin());
+	BranchCond->GetConditionPin()->MakeLinkTo(NextFunc->GetReturnValuePin());
+	CompilerContext.MovePinLinksToIntermediate(*CompletedPin, *Branch_Else);
+
+	// Loop body first, then back to Next
 	UK2Node_ExecutionSequence* SequenceFunc = CompilerContext.SpawnIntermediateNode<UK2Node_ExecutionSequence>(this, SourceGraph);
 	SequenceFunc->AllocateDefaultPins();
 
@@ -243,77 +303,77 @@ void UK2Node_InternalIterate::ExpandNode(FKismetCompilerContext& CompilerContext
 	UEdGraphPin* Sequence_Two = SequenceFunc->GetThenPinGivenIndex(1);
 
 	Branch_Then->MakeLinkTo(Sequence_Exec);
-	CompilerContext.MovePinLinksToIntermediate(*ForEachPin, *Sequence_One);
 
-	UK2Node_CallFunction* GetArrayElemFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-	GetArrayElemFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UKismetArrayLibrary, Array_Get), UKismetArrayLibrary::StaticClass());
-	GetArrayElemFunc->AllocateDefaultPins();
-
-	UEdGraphPin* GetElement_Array = GetArrayElemFunc->FindPinChecked(TEXT("TargetArray"));
-	UEdGraphPin* GetElement_Index = GetArrayElemFunc->FindPinChecked(TEXT("Index"));
-	UEdGraphPin* GetElement_Return = GetArrayElemFunc->FindPinChecked(TEXT("Item"));
-
-	// Connect here too
-	GetElement_Array->PinType = ArrayPin->PinType;
-	GetElement_Return->PinType = ArrayElementPin->PinType;
+	if (LoopMode == EForEachLoopMode::Awaitable)
+	{
+		// Only moves on once the body says so, the counter and length are ubergraph locals and survive the wait
+		CompilerContext.MovePinLinksToIntermediate(*ForEachMapNodeHelpers::GetContinuePin(this), *Next_Exec);
+	}
+	else
+	{
+		Sequence_Two->MakeLinkTo(Next_Exec);
+	}
 
-	CompilerContext.CopyPinLinksToIntermediate(*ArrayPin,*GetElement_Array);
-	GetElement_Index->MakeLinkTo(TempVar_Pin);
-	CompilerContext.MovePinLinksToIntermediate(*ArrayElementPin,*GetElement_Return);
+	// Nobody reading the element means there is nothing to fetch, the loop body hangs straight off the sequence
+	if (ArrayElementPin->LinkedTo.Num() > 0)
+	{
+		// The element is fetched once per iteration into a local, every reader in the loop body shares that
+		UK2Node_TemporaryVariable* ElementVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+		ElementVar->VariableType = ArrayElementPin->PinType;
+		ElementVar->AllocateDefaultPins();
 
-	// Increment the loop counter
-	UK2Node_AssignmentStatement* IncrVarFunc = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
-	IncrVarFunc->AllocateDefaultPins();
+		UEdGraphPin* ElementVar_Pin = ElementVar->GetVariablePin();
+		CompilerContext.MovePinLinksToIntermediate(*ArrayElementPin, *ElementVar_Pin);
 
-	UEdGraphPin* Inc_Exec = IncrVarFunc->GetExecPin();
-	UEdGraphPin* Inc_Variable = IncrVarFunc->GetVariablePin();
-	UEdGraphPin* Inc_Value = IncrVarFunc->GetValuePin();
-	UEdGraphPin* Inc_Then = IncrVarFunc->GetThenPin();
+		UK2Node_AssignmentStatement* FetchElement = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
+		FetchElement->AllocateDefaultPins();
 
-	// And connect again.
-	Sequence_Two->MakeLinkTo(Inc_Exec);
-	Branch_Exec->MakeLinkTo(Inc_Then);
-	Schema->TryCreateConnection(TempVar_Pin, Inc_Variable);
+		Sequence_One->MakeLinkTo(FetchElement->GetExecPin());
+		Schema->TryCreateConnection(FetchElement->GetVariablePin(), ElementVar_Pin);
+		CompilerContext.MovePinLinksToIntermediate(*ForEachPin, *FetchElement->GetThenPin());
 
-	UK2Node_CallFunction* AddOneFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-	AddOneFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Add_IntInt), UKismetMathLibrary::StaticClass());
-	AddOneFunc->AllocateDefaultPins();
+		UK2Node_CallFunction* GetArrayElemFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+		GetArrayElemFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UKismetArrayLibrary, Array_Get), UKismetArrayLibrary::StaticClass());
+		GetArrayElemFunc->AllocateDefaultPins();
 
-	UEdGraphPin* Add_A = AddOneFunc->FindPinChecked(TEXT("A"));
-	UEdGraphPin* Add_B = AddOneFunc->FindPinChecked(TEXT("B"));
-	UEdGraphPin* Add_Return = AddOneFunc->GetReturnValuePin();
+		UEdGraphPin* GetElement_Array = GetArrayElemFunc->FindPinChecked(TEXT("TargetArray"));
+		UEdGraphPin* GetElement_Index = GetArrayElemFunc->FindPinChecked(TEXT("Index"));
+		UEdGraphPin* GetElement_Return = GetArrayElemFunc->FindPinChecked(TEXT("Item"));
 
-	// Guess what? Connect again.
-	TempVar_Pin->MakeLinkTo(Add_A);
-	Add_B->DefaultValue = TEXT("1"); // <-- D: again initializing an integer using a char
-	Add_Return->MakeLinkTo(Inc_Value);
+		// Connect here too
+		GetElement_Array->PinType = ArrayPin->PinType;
+		GetElement_Return->PinType = ArrayElementPin->PinType;
 
+		CompilerContext.CopyPinLinksToIntermediate(*ArrayPin,*GetElement_Array);
+		GetElement_Index->MakeLinkTo(TempVar_Pin);
+		GetElement_Return->MakeLinkTo(FetchElement->GetValuePin());
+	}
+	else
+	{
+		CompilerContext.MovePinLinksToIntermediate(*ForEachPin, *Sequence_One);
+	}
 
-	// Break login nodes
+	// Breaking parks the counter on the cached length, so the pending Next bails out without touching the array
 	UEdGraphPin* BreakPin = GetBreakPin();
+	if (BreakPin->LinkedTo.Num() > 0)
+	{
+		UK2Node_AssignmentStatement* SetVarFunc = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
+		SetVarFunc->AllocateDefaultPins();
 
-	UK2Node_AssignmentStatement* SetVarFunc = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
-	SetVarFunc->AllocateDefaultPins();
-
-	UEdGraphPin* Set_Exec = SetVarFunc->GetExecPin();
-	UEdGraphPin* Set_Variable = SetVarFunc->GetVariablePin();
-	UEdGraphPin* Set_Value = SetVarFunc->GetValuePin();
-
-	CompilerContext.MovePinLinksToIntermediate(*BreakPin, *Set_Exec);
-	Schema->TryCreateConnection(TempVar_Pin,Set_Variable);
-
-	UK2Node_CallFunction* GetArrLastIndexFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this,SourceGraph);
-	GetArrLastIndexFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UKismetArrayLibrary, Array_LastIndex), UKismetArrayLibrary::StaticClass());
-	GetArrLastIndexFunc->AllocateDefaultPins();
-
-	UEdGraphPin* GetIndex_Array = GetArrLastIndexFunc->FindPinChecked(TEXT("TargetArray"));
-	UEdGraphPin* GetIndex_Return = GetArrLastIndexFunc->GetReturnValuePin();
+		UEdGraphPin* Set_Exec = SetVarFunc->GetExecPin();
+		UEdGraphPin* Set_Variable = SetVarFunc->GetVariablePin();
+		UEdGraphPin* Set_Value = SetVarFunc->GetValuePin();
 
-	// Troll user by pretending to pretend that we would connect the nodes :P
-	GetIndex_Array->PinType = ArrayPin->PinType;
-	CompilerContext.CopyPinLinksToIntermediate(*ArrayPin,*GetIndex_Array);
+		CompilerContext.MovePinLinksToIntermediate(*BreakPin, *Set_Exec);
+		Schema->TryCreateConnection(TempVar_Pin,Set_Variable);
+		LengthVar_Pin->MakeLinkTo(Set_Value);
 
-	GetIndex_Return->MakeLinkTo(Set_Value);
+		// Awaitable loops don't loop back on their own, Next has to see the parked counter to get to Completed
+		if (LoopMode == EForEachLoopMode::Awaitable)
+		{
+			SetVarFunc->GetThenPin()->MakeLinkTo(Next_Exec);
+		}
+	}
 
 	// Finally done!
 	BreakAllNodeLinks();
@@ -321,7 +381,17 @@ void UK2Node_InternalIterate::ExpandNode(FKismetCompilerContext& CompilerContext
 
 FText UK2Node_InternalIterate::GetNodeTitle(ENodeTitleType::Type TitleType) const
 {
-	return LOCTEXT( "NodeTitle", "Internal Iterate" );
+	if (LoopMode == EForEachLoopMode::Awaitable)
+	{
+		return LOCTEXT( "NodeTitle_Awaitable", "Internal Iterate (Awaitable)" );
+	}
+
+	return ForEachMapNodeHelpers::AppendLoopStats(this, TitleType, LOCTEXT( "NodeTitle", "Internal Iterate" ));
+}
+
+FLinearColor UK2Node_InternalIterate::GetNodeTitleColor() const
+{
+	return ForEachMapNodeHelpers::GetLoopHeatColor(this, Super::GetNodeTitleColor());
 }
 
 FText UK2Node_InternalIterate::GetTooltipText() const
@@ -378,6 +448,20 @@ void UK2Node_InternalIterate::PostPasteNode()
 	}
 }
 
+void UK2Node_InternalIterate::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, bRanged) ||
+		PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, LoopMode))
+	{
+		// Range and Continue pins come and go with the options
+		ReconstructNode();
+		GetGraph()->NotifyGraphChanged();
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+}
+
 bool UK2Node_InternalIterate::CheckForErrors(const FKismetCompilerContext& CompilerContext)
 {
 	if (GetArrayPin()->LinkedTo.Num() == 0)
@@ -388,5 +472,5 @@ bool UK2Node_InternalIterate::CheckForErrors(const FKismetCompilerContext& Compi
 		return true;
 	}
 
-	return false;
+	return ForEachMapNodeHelpers::CheckLoopModeForErrors(CompilerContext, this, LoopMode);
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ForEachLoopTypes.h"
 #include "K2Node.h"
 #include "K2Node_InternalIterate.generated.h"
 
@@ -32,9 +33,14 @@ public:
 	virtual void ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph ) override;
 	virtual FText GetNodeTitle( ENodeTitleType::Type TitleType ) const override;
 	virtual FText GetTooltipText( ) const override;
+	virtual FLinearColor GetNodeTitleColor( ) const override;
 	virtual FSlateIcon GetIconAndTint( FLinearColor& OutColor ) const override;
 	virtual void PinConnectionListChanged( UEdGraphPin* Pin ) override;
 	virtual void PostPasteNode( ) override;
+	virtual bool ShouldShowNodeProperties( ) const override { return true; }
+
+	// UObject API
+	virtual void PostEditChangeProperty( FPropertyChangedEvent& PropertyChangedEvent ) override;
 
 private:
 	// Determine if there is any configuration options that shouldn't be allowed
@@ -45,4 +51,16 @@ private:
 
 	UPROPERTY()
 	FEdGraphPinType CurrentInputType;
+
+	/** Whether the loop runs right away, or waits for Continue between elements */
+	UPROPERTY(EditDefaultsOnly, Category = InternalIterate, meta = (InvalidEnumValues = "TimeSliced"))
+	EForEachLoopMode LoopMode = EForEachLoopMode::Immediate;
+
+	/** Adds Start, Count and Stride pins, to only visit a window of the array or every Nth element */
+	UPROPERTY(EditDefaultsOnly, Category = InternalIterate, meta = (DisplayName = "Range"))
+	bool bRanged = false;
+
+	/** Walks the array back to front, a range counts from the back as well */
+	UPROPERTY(EditDefaultsOnly, Category = InternalIterate, meta = (DisplayName = "Reverse"))
+	bool bReverse = false;
 };
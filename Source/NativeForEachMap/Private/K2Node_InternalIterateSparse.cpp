@@ -0,0 +1,526 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "K2Node_InternalIterateSparse.h"
+
+#include "ForEachMapLibrary.h"
+#include "ForEachMapNodeHelpers.h"
+#include "K2Node_AssignmentStatement.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_TemporaryVariable.h"
+#include "KismetCompiler.h"
+#include "Kismet/KismetSystemLibrary.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(K2Node_InternalIterateSparse)
+
+#define LOCTEXT_NAMESPACE "K2Node_InternalIterateSparse"
+
+namespace InternalIterateSparse_PinNames
+{
+	static const FName ContainerPin(TEXT("ContainerPin"));
+	static const FName BreakPin(TEXT("BreakPin"));
+	static const FName RemovePin(TEXT("RemovePin"));
+	static const FName SetValuePin(TEXT("SetValuePin"));
+	static const FName NewValuePin(TEXT("NewValuePin"));
+	static const FName KeyPin(TEXT("KeyPin"));
+	static const FName ValuePin(TEXT("ValuePin"));
+	static const FName ValueSetPin(TEXT("ValueSetPin"));
+	static const FName IndexPin(TEXT("IndexPin"));
+	static const FName CompletedPin(TEXT("CompletedPin"));
+}
+
+UEdGraphPin* UK2Node_InternalIterateSparse::GetContainerPin() const
+{
+	return FindPinChecked(InternalIterateSparse_PinNames::ContainerPin);
+}
+
+UEdGraphPin* UK2Node_InternalIterateSparse::GetBreakPin() const
+{
+	return FindPinChecked(InternalIterateSparse_PinNames::BreakPin);
+}
+
+UEdGraphPin* UK2Node_InternalIterateSparse::GetRemovePin() const
+{
+	return FindPinChecked(InternalIterateSparse_PinNames::RemovePin);
+}
+
+UEdGraphPin* UK2Node_InternalIterateSparse::GetSetValuePin() const
+{
+	return FindPin(InternalIterateSparse_PinNames::SetValuePin);
+}
+
+UEdGraphPin* UK2Node_InternalIterateSparse::GetNewValuePin() const
+{
+	return FindPin(InternalIterateSparse_PinNames::NewValuePin);
+}
+
+UEdGraphPin* UK2Node_InternalIterateSparse::GetForEachPin() const
+{
+	return FindPinChecked(UEdGraphSchema_K2::PN_Then);
+}
+
+UEdGraphPin* UK2Node_InternalIterateSparse::GetKeyPin() const
+{
+	return FindPinChecked(InternalIterateSparse_PinNames::KeyPin);
+}
+
+UEdGraphPin* UK2Node_InternalIterateSparse::GetValuePin() const
+{
+	return FindPin(InternalIterateSparse_PinNames::ValuePin);
+}
+
+UEdGraphPin* UK2Node_InternalIterateSparse::GetValueSetPin() const
+{
+	return FindPin(InternalIterateSparse_PinNames::ValueSetPin);
+}
+
+UEdGraphPin* UK2Node_InternalIterateSparse::GetIndexPin() const
+{
+	return FindPinChecked(InternalIterateSparse_PinNames::IndexPin);
+}
+
+UEdGraphPin* UK2Node_InternalIterateSparse::GetCompletedPin() const
+{
+	return FindPinChecked(InternalIterateSparse_PinNames::CompletedPin);
+}
+
+void UK2Node_InternalIterateSparse::AllocateDefaultPins()
+{
+	Super::AllocateDefaultPins( );
+
+	// INPUT: Exec
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute);
+
+	const bool bIsMap = ContainerType == EPinContainerType::Map;
+	check(bIsMap || ContainerType == EPinContainerType::Set);
+
+	// INPUT: Container Type
+	FCreatePinParams _params;
+	_params.ContainerType = ContainerType;
+	_params.ValueTerminalType.TerminalCategory = UEdGraphSchema_K2::PC_Wildcard;
+
+	UEdGraphPin* ContainerPin =
+		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, InternalIterateSparse_PinNames::ContainerPin, _params);
+	if (ensure(ContainerPin))
+	{
+		ContainerPin->PinType.bIsConst = true;
+		ContainerPin->PinType.bIsReference = true;
+	}
+
+	// INPUT: Break pin
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, InternalIterateSparse_PinNames::BreakPin);
+
+	// INPUT: Removes the current entry
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, InternalIterateSparse_PinNames::RemovePin);
+
+	// INPUT: Per-frame budget
+	if (LoopMode == EForEachLoopMode::TimeSliced)
+	{
+		ForEachMapNodeHelpers::CreateTimeSlicePins(this);
+	}
+
+	// INPUT: Moves an awaitable loop on
+	if (LoopMode == EForEachLoopMode::Awaitable)
+	{
+		ForEachMapNodeHelpers::CreateContinuePin(this);
+	}
+
+	// INPUT: Window of the walk
+	if (bRanged)
+	{
+		ForEachMapNodeHelpers::CreateRangePins(this);
+	}
+
+	// INPUT: Write-through of the current value
+	if (bIsMap)
+	{
+		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, InternalIterateSparse_PinNames::SetValuePin);
+		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, InternalIterateSparse_PinNames::NewValuePin);
+	}
+
+	// OUTPUT: Loop Body
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then);
+
+	// OUTPUT: Key, or the element for sets
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, InternalIterateSparse_PinNames::KeyPin);
+
+	if (bIsMap)
+	{
+		// OUTPUT: Value
+		CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, InternalIterateSparse_PinNames::ValuePin);
+
+		// OUTPUT: Continues after the current value was written
+		CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, InternalIterateSparse_PinNames::ValueSetPin);
+	}
+
+	// OUTPUT: Index
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Int, InternalIterateSparse_PinNames::IndexPin);
+
+	// OUTPUT: Completed Exec
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, InternalIterateSparse_PinNames::CompletedPin);
+}
+
+void UK2Node_InternalIterateSparse::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	if (CheckForErrors(CompilerContext))
+	{
+		BreakAllNodeLinks();
+		return;
+	}
+
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+	const bool bIsMap = ContainerType == EPinContainerType::Map;
+
+	UEdGraphPin* ExecPin = GetExecPin();
+	UEdGraphPin* ContainerPin = GetContainerPin();
+	UEdGraphPin* BreakPin = GetBreakPin();
+	UEdGraphPin* RemovePin = GetRemovePin();
+	UEdGraphPin* ForEachPin = GetForEachPin();
+	UEdGraphPin* SetValuePin = GetSetValuePin();
+	UEdGraphPin* NewValuePin = GetNewValuePin();
+	UEdGraphPin* KeyPin = GetKeyPin();
+	UEdGraphPin* ValuePin = GetValuePin();
+	UEdGraphPin* ValueSetPin = GetValueSetPin();
+	UEdGraphPin* IndexPin = GetIndexPin();
+	UEdGraphPin* CompletedPin = GetCompletedPin();
+
+	// Frame spanning loops would leave their scope open across frames, only immediate runs get traced
+	if (LoopMode == EForEachLoopMode::Immediate)
+	{
+		ForEachMapNodeHelpers::WrapInTraceScope(CompilerContext, this, SourceGraph, ExecPin, ForEachPin, CompletedPin);
+	}
+
+	// A pure source would be re-run by every iterator call, evaluate it once up front instead
+	ForEachMapNodeHelpers::CaptureInputOnce(CompilerContext, this, SourceGraph, ExecPin, ContainerPin);
+
+	// Every iterator function reads the container straight from the source pin (or the captured local), no copies are being made
+	auto SpawnIteratorFunc = [&](const FName MapFunctionName, const FName SetFunctionName) -> UK2Node_CallFunction*
+	{
+		UK2Node_CallFunction* CallFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+		CallFunc->FunctionReference.SetExternalMember(bIsMap ? MapFunctionName : SetFunctionName, UForEachMapLibrary::StaticClass());
+		CallFunc->AllocateDefaultPins();
+
+		UEdGraphPin* CallFunc_Container = CallFunc->FindPinChecked(bIsMap ? TEXT("TargetMap") : TEXT("TargetSet"));
+		CompilerContext.CopyPinLinksToIntermediate(*ContainerPin, *CallFunc_Container);
+		CallFunc->PinConnectionListChanged(CallFunc_Container);
+
+		return CallFunc;
+	};
+
+	// Local holding the sparse index of the current pair
+	UK2Node_TemporaryVariable* SparseIndexVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+	SparseIndexVar->VariableType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	SparseIndexVar->AllocateDefaultPins();
+	UEdGraphPin* SparseIndex_Pin = SparseIndexVar->GetVariablePin();
+
+	// Local holding the logical index, which is what the user gets to see
+	UK2Node_TemporaryVariable* IndexVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+	IndexVar->VariableType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	IndexVar->AllocateDefaultPins();
+	UEdGraphPin* Index_Pin = IndexVar->GetVariablePin();
+	CompilerContext.MovePinLinksToIntermediate(*IndexPin, *Index_Pin);
+
+	// Keys and values that are plain old data get copied byte by byte, instead of through their properties
+	const bool bPodKey = ForEachMapNodeHelpers::IsPlainOldDataType(KeyPin->PinType);
+	const bool bPodValue = bIsMap && ForEachMapNodeHelpers::IsPlainOldDataType(ValuePin->PinType);
+
+	// Only what the graph actually reads gets wired up, a loop nobody takes the value of doesn't fetch it either.
+	// The key (or element) is a pure read, the compiler prunes it on its own when unused
+	const bool bFetchValue = bIsMap && ValuePin->LinkedTo.Num() > 0;
+
+	// Local holding the value of the current pair, fetched once per iteration rather than looked up per read
+	UEdGraphPin* Value_Pin = nullptr;
+	if (bFetchValue)
+	{
+		UK2Node_TemporaryVariable* ValueVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+		ValueVar->VariableType = ValuePin->PinType;
+		ValueVar->VariableType.bIsReference = false;
+		ValueVar->AllocateDefaultPins();
+		Value_Pin = ValueVar->GetVariablePin();
+		CompilerContext.MovePinLinksToIntermediate(*ValuePin, *Value_Pin);
+	}
+
+	// Reads the current value into our local, straight from the pair's storage
+	auto SpawnFetchValue = [&]() -> UK2Node_AssignmentStatement*
+	{
+		UK2Node_AssignmentStatement* Fetch_Value = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
+		Fetch_Value->AllocateDefaultPins();
+		Schema->TryCreateConnection(Fetch_Value->GetVariablePin(), Value_Pin);
+
+		UK2Node_CallFunction* GetValueFunc = SpawnIteratorFunc(
+			bPodValue ? GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_IteratorGetPodValue) : GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_IteratorGetValue),
+			NAME_None);
+		GetValueFunc->FindPinChecked(TEXT("SparseIndex"))->MakeLinkTo(SparseIndex_Pin);
+		Schema->TryCreateConnection(GetValueFunc->FindPinChecked(TEXT("Value")), Fetch_Value->GetValuePin());
+
+		return Fetch_Value;
+	};
+
+	// SparseIndex = Index = INDEX_NONE, the first Next moves both onto the first slot
+	UK2Node_AssignmentStatement* Init_SparseIndex = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
+	Init_SparseIndex->AllocateDefaultPins();
+	CompilerContext.MovePinLinksToIntermediate(*ExecPin, *Init_SparseIndex->GetExecPin());
+	Schema->TryCreateConnection(Init_SparseIndex->GetVariablePin(), SparseIndex_Pin);
+	Init_SparseIndex->GetValuePin()->DefaultValue = LexToString(INDEX_NONE);
+
+	UK2Node_AssignmentStatement* Init_Index = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
+	Init_Index->AllocateDefaultPins();
+	Init_SparseIndex->GetThenPin()->MakeLinkTo(Init_Index->GetExecPin());
+	Schema->TryCreateConnection(Init_Index->GetVariablePin(), Index_Pin);
+	Init_Index->GetValuePin()->DefaultValue = LexToString(INDEX_NONE);
+
+	UEdGraphPin* LoopEntry_Pin = Init_Index->GetThenPin();
+
+	// Lets removals through our own pin tell a mutation safe loop that they were expected
+	UEdGraphPin* Guard_Pin = nullptr;
+	if (bMutationSafe || RemovePin->LinkedTo.Num() > 0)
+	{
+		UK2Node_TemporaryVariable* GuardVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+		GuardVar->VariableType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+		GuardVar->VariableType.PinSubCategoryObject = FForEachMutationGuard::StaticStruct();
+		GuardVar->AllocateDefaultPins();
+		Guard_Pin = GuardVar->GetVariablePin();
+	}
+
+	// Next(Container, SparseIndex, Index) does all the loop bookkeeping in a single native call
+	UK2Node_CallFunction* NextFunc = nullptr;
+	if (Order == EForEachOrder::Unordered && bMutationSafe)
+	{
+		// Still walks the live storage, the guard only makes it check for changes per step
+		NextFunc = SpawnIteratorFunc(
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_GuardedIteratorNext),
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Set_GuardedIteratorNext));
+		NextFunc->FindPinChecked(TEXT("Guard"))->MakeLinkTo(Guard_Pin);
+
+		// Only filled once the body actually changed the container, the same local is reused by every run of the loop
+		UK2Node_TemporaryVariable* SnapshotVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+		SnapshotVar->VariableType = ContainerPin->PinType;
+		SnapshotVar->VariableType.bIsConst = false;
+		SnapshotVar->VariableType.bIsReference = false;
+		SnapshotVar->AllocateDefaultPins();
+		NextFunc->FindPinChecked(TEXT("Snapshot"))->MakeLinkTo(SnapshotVar->GetVariablePin());
+	}
+	else if (Order == EForEachOrder::Unordered && IsRanged())
+	{
+		// Skipping happens natively, the VM only sees the entries that are visited
+		NextFunc = SpawnIteratorFunc(
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_RangedIteratorNext),
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Set_RangedIteratorNext));
+		ForEachMapNodeHelpers::ConnectRangedNext(CompilerContext, this, NextFunc, bReverse);
+	}
+	else if (Order == EForEachOrder::Unordered)
+	{
+		NextFunc = SpawnIteratorFunc(
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_IteratorNext),
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Set_IteratorNext));
+
+		// Where the storage ended on loop entry, so entries the body appends don't keep the loop going
+		UK2Node_TemporaryVariable* EndIndexVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+		EndIndexVar->VariableType.PinCategory = UEdGraphSchema_K2::PC_Int;
+		EndIndexVar->AllocateDefaultPins();
+		NextFunc->FindPinChecked(TEXT("EndIndex"))->MakeLinkTo(EndIndexVar->GetVariablePin());
+	}
+	else
+	{
+		// Ordered walks sort the sparse indices once on entry, Next then follows them instead of the storage
+		const bool bByValue = Order == EForEachOrder::ValueAscending || Order == EForEachOrder::ValueDescending;
+		const bool bDescending = Order == EForEachOrder::KeyDescending || Order == EForEachOrder::ValueDescending;
+
+		UK2Node_CallFunction* SortFunc = SpawnIteratorFunc(
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_SortedIndices),
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Set_SortedIndices));
+		if (bIsMap)
+		{
+			SortFunc->FindPinChecked(TEXT("bByValue"))->DefaultValue = LexToString(bByValue);
+		}
+		SortFunc->FindPinChecked(TEXT("bDescending"))->DefaultValue = LexToString(bDescending);
+		SortFunc->FindPinChecked(TEXT("TopK"))->DefaultValue = LexToString(TopK);
+		LoopEntry_Pin->MakeLinkTo(SortFunc->GetExecPin());
+		LoopEntry_Pin = SortFunc->GetThenPin();
+
+		// Next checks the sorted slots against the live container, the body may have emptied some of them by now
+		NextFunc = IsRanged()
+			? SpawnIteratorFunc(GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_SortedRangedIteratorNext), GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Set_SortedRangedIteratorNext))
+			: SpawnIteratorFunc(GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_SortedIteratorNext), GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Set_SortedIteratorNext));
+		NextFunc->FindPinChecked(TEXT("SparseIndices"))->MakeLinkTo(SortFunc->FindPinChecked(TEXT("SparseIndices")));
+
+		if (IsRanged())
+		{
+			ForEachMapNodeHelpers::ConnectRangedNext(CompilerContext, this, NextFunc, bReverse);
+		}
+	}
+	NextFunc->FindPinChecked(TEXT("SparseIndex"))->MakeLinkTo(SparseIndex_Pin);
+	NextFunc->FindPinChecked(TEXT("Index"))->MakeLinkTo(Index_Pin);
+
+	// Loop condition, did Next land on a slot?
+	UK2Node_IfThenElse* BranchCond = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
+	BranchCond->AllocateDefaultPins();
+	NextFunc->GetThenPin()->MakeLinkTo(BranchCond->GetExecPin());
+	BranchCond->GetConditionPin()->MakeLinkTo(NextFunc->GetReturnValuePin());
+	CompilerContext.MovePinLinksToIntermediate(*CompletedPin, *BranchCond->GetElsePin());
+
+	// Loop body first, advance afterward
+	UK2Node_ExecutionSequence* SequenceFunc = CompilerContext.SpawnIntermediateNode<UK2Node_ExecutionSequence>(this, SourceGraph);
+	SequenceFunc->AllocateDefaultPins();
+	BranchCond->GetThenPin()->MakeLinkTo(SequenceFunc->GetExecPin());
+
+	if (LoopMode == EForEachLoopMode::TimeSliced)
+	{
+		// Budget bookkeeping of the current frame's slice
+		UK2Node_TemporaryVariable* TimeSliceVar = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+		TimeSliceVar->VariableType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+		TimeSliceVar->VariableType.PinSubCategoryObject = FForEachTimeSlice::StaticStruct();
+		TimeSliceVar->AllocateDefaultPins();
+		UEdGraphPin* TimeSlice_Pin = TimeSliceVar->GetVariablePin();
+
+		// Starts a fresh slice, then carries on with Next
+		auto SpawnBeginSlice = [&]() -> UEdGraphPin*
+		{
+			UK2Node_CallFunction* BeginSliceFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+			BeginSliceFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, TimeSlice_Begin), UForEachMapLibrary::StaticClass());
+			BeginSliceFunc->AllocateDefaultPins();
+			BeginSliceFunc->FindPinChecked(TEXT("TimeSlice"))->MakeLinkTo(TimeSlice_Pin);
+			BeginSliceFunc->GetThenPin()->MakeLinkTo(NextFunc->GetExecPin());
+
+			return BeginSliceFunc->GetExecPin();
+		};
+
+		LoopEntry_Pin->MakeLinkTo(SpawnBeginSlice());
+
+		// After each iteration, either carry on right away or wait for the next frame.
+		// Next re-validates the slot once we're back, so the container may change in between
+		UK2Node_CallFunction* ShouldYieldFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+		ShouldYieldFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, TimeSlice_ShouldYield), UForEachMapLibrary::StaticClass());
+		ShouldYieldFunc->AllocateDefaultPins();
+		ShouldYieldFunc->FindPinChecked(TEXT("TimeSlice"))->MakeLinkTo(TimeSlice_Pin);
+		CompilerContext.MovePinLinksToIntermediate(*ForEachMapNodeHelpers::GetBudgetMsPin(this), *ShouldYieldFunc->FindPinChecked(TEXT("BudgetMs")));
+		CompilerContext.MovePinLinksToIntermediate(*ForEachMapNodeHelpers::GetBudgetIterationsPin(this), *ShouldYieldFunc->FindPinChecked(TEXT("BudgetIterations")));
+		SequenceFunc->GetThenPinGivenIndex(1)->MakeLinkTo(ShouldYieldFunc->GetExecPin());
+
+		UK2Node_IfThenElse* YieldBranch = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
+		YieldBranch->AllocateDefaultPins();
+		ShouldYieldFunc->GetThenPin()->MakeLinkTo(YieldBranch->GetExecPin());
+		YieldBranch->GetConditionPin()->MakeLinkTo(ShouldYieldFunc->GetReturnValuePin());
+		YieldBranch->GetElsePin()->MakeLinkTo(NextFunc->GetExecPin());
+
+		UK2Node_CallFunction* DelayFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+		DelayFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, DelayUntilNextTick), UKismetSystemLibrary::StaticClass());
+		DelayFunc->AllocateDefaultPins();
+		YieldBranch->GetThenPin()->MakeLinkTo(DelayFunc->GetExecPin());
+		DelayFunc->GetThenPin()->MakeLinkTo(SpawnBeginSlice());
+	}
+	else if (LoopMode == EForEachLoopMode::Awaitable)
+	{
+		// The body decides when to move on, it may well be frames later. All the loop state lives in
+		// ubergraph locals, which outlive the latent actions in between, so Next simply picks up where we left
+		LoopEntry_Pin->MakeLinkTo(NextFunc->GetExecPin());
+		CompilerContext.MovePinLinksToIntermediate(*ForEachMapNodeHelpers::GetContinuePin(this), *NextFunc->GetExecPin());
+	}
+	else
+	{
+		LoopEntry_Pin->MakeLinkTo(NextFunc->GetExecPin());
+		SequenceFunc->GetThenPinGivenIndex(1)->MakeLinkTo(NextFunc->GetExecPin());
+	}
+
+	if (bFetchValue)
+	{
+		UK2Node_AssignmentStatement* Body_FetchValue = SpawnFetchValue();
+		SequenceFunc->GetThenPinGivenIndex(0)->MakeLinkTo(Body_FetchValue->GetExecPin());
+		CompilerContext.MovePinLinksToIntermediate(*ForEachPin, *Body_FetchValue->GetThenPin());
+	}
+	else
+	{
+		CompilerContext.MovePinLinksToIntermediate(*ForEachPin, *SequenceFunc->GetThenPinGivenIndex(0));
+	}
+
+	// Breaking parks the sparse index on IteratorEnd, which Next never leaves again
+	if (BreakPin->LinkedTo.Num() > 0)
+	{
+		UK2Node_AssignmentStatement* Break_SparseIndex = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
+		Break_SparseIndex->AllocateDefaultPins();
+		CompilerContext.MovePinLinksToIntermediate(*BreakPin, *Break_SparseIndex->GetExecPin());
+		Schema->TryCreateConnection(Break_SparseIndex->GetVariablePin(), SparseIndex_Pin);
+		Break_SparseIndex->GetValuePin()->DefaultValue = LexToString(UForEachMapLibrary::IteratorEnd);
+
+		// Awaitable loops don't loop back on their own, Next has to see the parked index to get to Completed
+		if (LoopMode == EForEachLoopMode::Awaitable)
+		{
+			Break_SparseIndex->GetThenPin()->MakeLinkTo(NextFunc->GetExecPin());
+		}
+	}
+
+	// Remove Current takes the slot out in place, the next Next simply moves on to the following one
+	if (Guard_Pin != nullptr)
+	{
+		UK2Node_CallFunction* RemoveFunc = SpawnIteratorFunc(
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_IteratorRemove),
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Set_IteratorRemove));
+		RemoveFunc->FindPinChecked(TEXT("SparseIndex"))->MakeLinkTo(SparseIndex_Pin);
+		RemoveFunc->FindPinChecked(TEXT("Guard"))->MakeLinkTo(Guard_Pin);
+		CompilerContext.MovePinLinksToIntermediate(*RemovePin, *RemoveFunc->GetExecPin());
+
+		// Awaitable loops only move on when told to, removing counts as being done with the entry
+		if (LoopMode == EForEachLoopMode::Awaitable)
+		{
+			RemoveFunc->GetThenPin()->MakeLinkTo(NextFunc->GetExecPin());
+		}
+	}
+
+	// Set Current Value writes into the pair in place, then refreshes our local if there is one
+	if (bIsMap && SetValuePin->LinkedTo.Num() > 0)
+	{
+		UK2Node_CallFunction* SetValueFunc = SpawnIteratorFunc(GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_IteratorSetValue), NAME_None);
+		SetValueFunc->FindPinChecked(TEXT("SparseIndex"))->MakeLinkTo(SparseIndex_Pin);
+		CompilerContext.MovePinLinksToIntermediate(*SetValuePin, *SetValueFunc->GetExecPin());
+		CompilerContext.MovePinLinksToIntermediate(*NewValuePin, *SetValueFunc->FindPinChecked(TEXT("Value")));
+
+		if (bFetchValue)
+		{
+			UK2Node_AssignmentStatement* Set_FetchValue = SpawnFetchValue();
+			SetValueFunc->GetThenPin()->MakeLinkTo(Set_FetchValue->GetExecPin());
+			CompilerContext.MovePinLinksToIntermediate(*ValueSetPin, *Set_FetchValue->GetThenPin());
+		}
+		else
+		{
+			CompilerContext.MovePinLinksToIntermediate(*ValueSetPin, *SetValueFunc->GetThenPin());
+		}
+	}
+
+	// Key (or element) of the current slot, read straight out of the storage
+	UK2Node_CallFunction* GetKeyFunc = bPodKey
+		? SpawnIteratorFunc(
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_IteratorGetPodKey),
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Set_IteratorGetPodElement))
+		: SpawnIteratorFunc(
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_IteratorGetKey),
+			GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Set_IteratorGetElement));
+	GetKeyFunc->FindPinChecked(TEXT("SparseIndex"))->MakeLinkTo(SparseIndex_Pin);
+	CompilerContext.MovePinLinksToIntermediate(*KeyPin, *GetKeyFunc->FindPinChecked(bIsMap ? TEXT("Key") : TEXT("Element")));
+
+	// Done, the intermediate nodes took over
+	BreakAllNodeLinks();
+}
+
+FText UK2Node_InternalIterateSparse::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT( "NodeTitle", "Internal Iterate Sparse" );
+}
+
+bool UK2Node_InternalIterateSparse::CheckForErrors(const FKismetCompilerContext& CompilerContext)
+{
+	if (GetContainerPin()->LinkedTo.Num() == 0)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT( "NoContainerEntry", "Internal Iterate Sparse node @@ requires a map or set input.").ToString(),
+			this);
+		return true;
+	}
+
+	return false;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,78 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ForEachLoopTypes.h"
+#include "K2Node.h"
+#include "K2Node_InternalIterateSparse.generated.h"
+
+/**
+ * Intermediate loop node that walks the sparse storage of a map or set in place,
+ * instead of snapshotting it into an array and iterating that.
+ * For maps the current value is fetched once per iteration and can be written back in place.
+ * Pin types are assigned by whoever spawns it.
+ */
+UCLASS()
+class UK2Node_InternalIterateSparse : public UK2Node
+{
+	GENERATED_BODY()
+
+public:
+	// Pin Accessors, the value related ones only exist for maps
+	UEdGraphPin* GetContainerPin() const;
+	UEdGraphPin* GetBreakPin() const;
+	UEdGraphPin* GetRemovePin() const;
+	UEdGraphPin* GetSetValuePin() const;
+	UEdGraphPin* GetNewValuePin() const;
+
+	UEdGraphPin* GetForEachPin() const;
+	UEdGraphPin* GetKeyPin() const;
+	UEdGraphPin* GetValuePin() const;
+	UEdGraphPin* GetValueSetPin() const;
+	UEdGraphPin* GetIndexPin() const;
+	UEdGraphPin* GetCompletedPin() const;
+
+	// K2Node API
+	virtual bool IsNodeSafeToIgnore( ) const override { return true; }
+
+	// EdGraphNode API
+	virtual void AllocateDefaultPins( ) override;
+	virtual void ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph ) override;
+	virtual FText GetNodeTitle( ENodeTitleType::Type TitleType ) const override;
+
+	/** Which container we walk, either Map or Set. Has to be assigned before the pins are allocated */
+	UPROPERTY()
+	EPinContainerType ContainerType = EPinContainerType::Map;
+
+	/** How the loop runs, time-sliced loops get budget pins. Has to be assigned before the pins are allocated as well */
+	UPROPERTY()
+	EForEachLoopMode LoopMode = EForEachLoopMode::Immediate;
+
+	/** Whether the loop notices the body changing the container, and carries on from a snapshot of what was left then */
+	UPROPERTY()
+	bool bMutationSafe = false;
+
+	/** Order to walk the container in, anything but Unordered sorts the sparse indices on loop entry */
+	UPROPERTY()
+	EForEachOrder Order = EForEachOrder::Unordered;
+
+	/** Only walks the first TopK entries of the order, zero walks all of them */
+	UPROPERTY()
+	int32 TopK = 0;
+
+	/** Whether the walk is limited by the Start, Count and Stride pins */
+	UPROPERTY()
+	bool bRanged = false;
+
+	/** Walks from the back, the range counts from there as well */
+	UPROPERTY()
+	bool bReverse = false;
+
+	/** Whether Next has to go through a ranged variant */
+	bool IsRanged() const { return bRanged || bReverse; }
+
+private:
+	// Determine if there is any configuration options that shouldn't be allowed
+	bool CheckForErrors( const FKismetCompilerContext& CompilerContext );
+};
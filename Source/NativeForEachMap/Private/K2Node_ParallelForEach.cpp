@@ -0,0 +1,274 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "K2Node_ParallelForEach.h"
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "ForEachMapLibrary.h"
+#include "ForEachMapNodeHelpers.h"
+#include "K2Node_CallFunction.h"
+#include "KismetCompiler.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(K2Node_ParallelForEach)
+
+#define LOCTEXT_NAMESPACE "K2Node_ParallelForEach"
+
+namespace ParallelForEach_PinNames
+{
+	static const FName ContainerPin(TEXT("ContainerPin"));
+}
+
+void UK2Node_ParallelForEach::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	Super::GetMenuActions(ActionRegistrar);
+
+	UClass* Action = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(Action))
+	{
+		// Same node for both containers, the spawner decides which one it is
+		auto AddSpawner = [&](EPinContainerType InContainerType, const FText& MenuName)
+		{
+			UBlueprintNodeSpawner* GetNodeSpawner = UBlueprintNodeSpawner::Create(Action);
+			check(GetNodeSpawner != nullptr);
+
+			GetNodeSpawner->DefaultMenuSignature.MenuName = MenuName;
+			GetNodeSpawner->CustomizeNodeDelegate = UBlueprintNodeSpawner::FCustomizeNodeDelegate::CreateLambda(
+				[InContainerType](UEdGraphNode* NewNode, bool /*bIsTemplateNode*/)
+				{
+					CastChecked<UK2Node_ParallelForEach>(NewNode)->ContainerType = InContainerType;
+				});
+
+			ActionRegistrar.AddBlueprintAction(Action, GetNodeSpawner);
+		};
+
+		AddSpawner(EPinContainerType::Map, LOCTEXT("NodeTitle_Map", "Parallel For Each Map"));
+		AddSpawner(EPinContainerType::Set, LOCTEXT("NodeTitle_Set", "Parallel For Each Set"));
+	}
+}
+
+FText UK2Node_ParallelForEach::GetMenuCategory() const
+{
+	return LOCTEXT("NodeMenuCategory", "Utilities|Array");
+}
+
+void UK2Node_ParallelForEach::AllocateDefaultPins()
+{
+	Super::AllocateDefaultPins();
+
+	const bool bIsMap = ContainerType == EPinContainerType::Map;
+	check(bIsMap || ContainerType == EPinContainerType::Set);
+
+	// Add default pins here
+	// INPUT: Exec
+	UEdGraphPin* ExecPin =
+		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute);
+	if (ensure(ExecPin))
+	{
+		ExecPin->PinFriendlyName = LOCTEXT("ExecPin_FriendlyName", "Execute");
+	}
+
+	FCreatePinParams _params;
+	_params.ContainerType = ContainerType;
+	_params.ValueTerminalType.TerminalCategory = UEdGraphSchema_K2::PC_Wildcard;
+
+	// INPUT: Container Type
+	UEdGraphPin* ContainerPin =
+		CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, ParallelForEach_PinNames::ContainerPin, _params);
+	if (ensure(ContainerPin))
+	{
+		ContainerPin->PinType.bIsConst = true;
+		ContainerPin->PinType.bIsReference = true;
+		ContainerPin->PinFriendlyName = bIsMap ? LOCTEXT( "MapPin_FriendlyName", "Map" ) : LOCTEXT( "SetPin_FriendlyName", "Set" );
+	}
+
+	// OUTPUT: Completed Exec, all entries are done by then
+	UEdGraphPin* CompletedPin =
+		CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then);
+	if (ensure(CompletedPin))
+	{
+		CompletedPin->PinFriendlyName = LOCTEXT( "CompletedPin_FriendlyName", "Completed" );
+	}
+
+	if (CachedInputType.PinCategory == NAME_None)
+	{
+		CachedInputWildcardType = CachedInputType = ContainerPin->PinType;
+	}
+	else
+	{
+		ContainerPin->PinType = CachedInputType;
+	}
+}
+
+void UK2Node_ParallelForEach::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	if (CheckForErrors( CompilerContext ))
+	{
+		BreakAllNodeLinks( );
+		return;
+	}
+
+	const bool bIsMap = ContainerType == EPinContainerType::Map;
+
+	// A single native call does all the work, the function name is baked in as a literal
+	UK2Node_CallFunction* ParallelFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	ParallelFunc->FunctionReference.SetExternalMember(
+		bIsMap ? GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_ParallelForEach) : GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Set_ParallelForEach),
+		UForEachMapLibrary::StaticClass());
+	ParallelFunc->AllocateDefaultPins();
+
+	UEdGraphPin* Parallel_Container = ParallelFunc->FindPinChecked(bIsMap ? TEXT("TargetMap") : TEXT("TargetSet"));
+	CompilerContext.MovePinLinksToIntermediate(*GetInputContainerPin(), *Parallel_Container);
+	ParallelFunc->PinConnectionListChanged(Parallel_Container);
+
+	ParallelFunc->FindPinChecked(TEXT("FunctionName"))->DefaultValue = FunctionName.ToString();
+
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *ParallelFunc->GetExecPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetCompletePin(), *ParallelFunc->GetThenPin());
+
+	// Break the links as the native call will handle the rest
+	BreakAllNodeLinks();
+}
+
+FText UK2Node_ParallelForEach::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	const FText Title = ContainerType == EPinContainerType::Set
+		? LOCTEXT("NodeTitle_Set", "Parallel For Each Set")
+		: LOCTEXT("NodeTitle_Map", "Parallel For Each Map");
+
+	if (TitleType == ENodeTitleType::FullTitle && !FunctionName.IsNone())
+	{
+		return FText::Format(LOCTEXT("NodeTitle_WithFunction", "{0}\nCalls {1}"), Title, FText::FromName(FunctionName));
+	}
+
+	return Title;
+}
+
+FText UK2Node_ParallelForEach::GetTooltipText() const
+{
+	return LOCTEXT("NodeTooltip", "Calls a Thread Safe function of this Blueprint once per entry, spread across worker threads. Completed fires once all entries are done.");
+}
+
+FText UK2Node_ParallelForEach::GetKeywords() const
+{
+	return FText::FromString(TEXT("For,Each,Loop,Map,Set,Parallel,Thread"));
+}
+
+FSlateIcon UK2Node_ParallelForEach::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static const FSlateIcon Icon = FSlateIcon(FAppStyle::GetAppStyleSetName(), "GraphEditor.Macro.ForEach_16x");
+	OutColor = FLinearColor::White;
+	return Icon;
+}
+
+FLinearColor UK2Node_ParallelForEach::GetNodeTitleColor() const
+{
+	return FLinearColor::White;
+}
+
+void UK2Node_ParallelForEach::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	Super::PinConnectionListChanged(Pin);
+
+	if (Pin == nullptr)
+	{
+		return;
+	}
+
+	if (Pin->PinName == ParallelForEach_PinNames::ContainerPin)
+	{
+		Pin->PinType = Pin->LinkedTo.Num() > 0 ? Pin->LinkedTo[0]->PinType : CachedInputWildcardType;
+		CachedInputType = Pin->PinType;
+
+		GetGraph()->NotifyGraphChanged();
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+}
+
+void UK2Node_ParallelForEach::PostPasteNode()
+{
+	Super::PostPasteNode();
+
+	if (UEdGraphPin* ContainerPin = GetInputContainerPin())
+	{
+		if (!ContainerPin->LinkedTo.Num())
+		{
+			ContainerPin->PinType = CachedInputType = CachedInputWildcardType;
+		}
+	}
+}
+
+void UK2Node_ParallelForEach::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, FunctionName))
+	{
+		// Poke the graph to update the title
+		GetGraph()->NotifyGraphChanged();
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+}
+
+UEdGraphPin* UK2Node_ParallelForEach::GetInputContainerPin() const
+{
+	return FindPinChecked(ParallelForEach_PinNames::ContainerPin);
+}
+
+UEdGraphPin* UK2Node_ParallelForEach::GetCompletePin() const
+{
+	return FindPinChecked(UEdGraphSchema_K2::PN_Then);
+}
+
+bool UK2Node_ParallelForEach::IsFunctionCompatible(const UFunction* Function) const
+{
+	return Function != nullptr &&
+		FBlueprintEditorUtils::HasFunctionBlueprintThreadSafeMetaData(Function) &&
+		ForEachMapNodeHelpers::IsEntryFunction(Function, GetInputContainerPin()->PinType, false);
+}
+
+TArray<FString> UK2Node_ParallelForEach::GetFunctionNameOptions() const
+{
+	return ForEachMapNodeHelpers::GetFunctionNames(GetBlueprint(), [this](const UFunction* Function)
+	{
+		return IsFunctionCompatible(Function);
+	});
+}
+
+bool UK2Node_ParallelForEach::CheckForErrors(const FKismetCompilerContext& CompilerContext)
+{
+	if (GetInputContainerPin()->LinkedTo.Num() == 0)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT( "NoContainerEntry", "Parallel For Each node @@ requires a map or set input.").ToString(),
+			this);
+		return true;
+	}
+
+	const UBlueprint* Blueprint = GetBlueprint();
+	const UFunction* Function = Blueprint && Blueprint->SkeletonGeneratedClass ? Blueprint->SkeletonGeneratedClass->FindFunctionByName(FunctionName) : nullptr;
+	if (Function == nullptr)
+	{
+		CompilerContext.MessageLog.Error(
+			*FText::Format(LOCTEXT( "FunctionNotFound", "Parallel For Each node @@ could not find function '{0}'."), FText::FromName(FunctionName)).ToString(),
+			this);
+		return true;
+	}
+
+	if (!IsFunctionCompatible(Function))
+	{
+		CompilerContext.MessageLog.Error(
+			*FText::Format(LOCTEXT( "FunctionIncompatible", "Parallel For Each node @@ can't call '{0}'. It has to be marked Thread Safe and take {1} as its only inputs."),
+				FText::FromName(FunctionName),
+				ContainerType == EPinContainerType::Map ? LOCTEXT("MapArguments", "(Key, Value)") : LOCTEXT("SetArguments", "(Element)")).ToString(),
+			this);
+		return true;
+	}
+
+	return false;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,71 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "K2Node.h"
+#include "K2Node_ParallelForEach.generated.h"
+
+/**
+ * Calls a thread safe function once per entry of a map or set, spread across worker threads.
+ * Completed fires on the calling thread once every entry has been processed.
+ */
+UCLASS(CollapseCategories)
+class NATIVEFOREACHMAP_API UK2Node_ParallelForEach : public UK2Node
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UK2Node Interface
+	virtual bool IsNodeSafeToIgnore() const override { return true; }
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	//~ End UK2Node Interface
+
+	//~ Begin UEdGraphNode Interface
+	virtual void AllocateDefaultPins() override;
+	virtual void ExpandNode(class FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetTooltipText() const override;
+	virtual FText GetKeywords() const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+	virtual bool ShouldShowNodeProperties() const override { return true; }
+	virtual void PostPasteNode() override;
+	//~ End UEdGraphNode Interface
+
+	//~ Begin UObject Interface
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	//~ End UObject Interface
+
+	/** Pin Accessors */
+	[[nodiscard]] UEdGraphPin* GetInputContainerPin() const;
+	[[nodiscard]] UEdGraphPin* GetCompletePin() const;
+
+	/** Which container we run over, either Map or Set. Assigned by the menu action that spawned us */
+	UPROPERTY()
+	EPinContainerType ContainerType = EPinContainerType::Map;
+
+protected:
+	/** Performs a generalized CheckForErrors lookup. */
+	virtual bool CheckForErrors(const FKismetCompilerContext& CompilerContext);
+
+	/** Whether the function is thread safe and takes exactly the entries of our container as inputs */
+	bool IsFunctionCompatible(const UFunction* Function) const;
+
+	/** Thread safe functions of this Blueprint that fit the container, for the details panel */
+	UFUNCTION()
+	TArray<FString> GetFunctionNameOptions() const;
+
+	/** Cached off types for the input pins */
+	UPROPERTY()
+	FEdGraphPinType CachedInputWildcardType;
+	UPROPERTY()
+	FEdGraphPinType CachedInputType;
+
+private:
+	/** The function to call per entry. Has to be marked Thread Safe, and take (Key, Value) for maps or (Element) for sets */
+	UPROPERTY(EditDefaultsOnly, Category = ParallelForEach, meta = (GetOptions = "GetFunctionNameOptions"))
+	FName FunctionName;
+};
@@ -0,0 +1,16 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class NativeForEachMapRuntime : ModuleRules
+{
+	public NativeForEachMapRuntime(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PublicDependencyModuleNames.AddRange(new []
+		{ 
+			"Core", 
+			"CoreUObject", 
+			"Engine"
+		});
+	}
+}
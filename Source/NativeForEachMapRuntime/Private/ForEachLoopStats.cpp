@@ -0,0 +1,84 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "ForEachLoopStats.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/ScopeLock.h"
+
+bool FForEachLoopStats::bEnabled = false;
+
+namespace ForEachLoopStats_Private
+{
+	static FAutoConsoleVariableRef CVarStats(
+		TEXT("ForEachMap.Stats"),
+		FForEachLoopStats::bEnabled,
+		TEXT("Counts the runs, iterations and time of every map, set and array loop node, shown on the nodes in the graph editor."),
+		ECVF_Default);
+
+	static FAutoConsoleCommand CommandReset(
+		TEXT("ForEachMap.Stats.Reset"),
+		TEXT("Starts the loop node counters of ForEachMap.Stats over."),
+		FConsoleCommandDelegate::CreateStatic(&FForEachLoopStats::Reset));
+
+	/** Loops run on worker threads too (thread safe functions of Parallel For Each) */
+	static FCriticalSection Mutex;
+	static TMap<FName, FForEachLoopNodeStats> NodeStats;
+	static double HottestSeconds = 0.0;
+
+	static FDelayedAutoRegisterHelper GRegisterReset(EDelayedRegisterRunPhase::EndOfEngineInit, []
+	{
+		FWorldDelegates::OnStartGameInstance.AddLambda([](UGameInstance*)
+		{
+			FForEachLoopStats::Reset();
+		});
+	});
+}
+
+void FForEachLoopStats::Record(FName ScopeName, int64 Iterations, double Seconds)
+{
+	using namespace ForEachLoopStats_Private;
+
+	FScopeLock Lock(&Mutex);
+
+	FForEachLoopNodeStats& Stats = NodeStats.FindOrAdd(ScopeName);
+	++Stats.Invocations;
+	Stats.Iterations += Iterations;
+	Stats.TotalSeconds += Seconds;
+
+	HottestSeconds = FMath::Max(HottestSeconds, Stats.TotalSeconds);
+}
+
+bool FForEachLoopStats::Find(FName ScopeName, FForEachLoopNodeStats& OutStats)
+{
+	using namespace ForEachLoopStats_Private;
+
+	FScopeLock Lock(&Mutex);
+
+	if (const FForEachLoopNodeStats* Stats = NodeStats.Find(ScopeName))
+	{
+		OutStats = *Stats;
+		return true;
+	}
+
+	return false;
+}
+
+double FForEachLoopStats::GetHottestSeconds()
+{
+	using namespace ForEachLoopStats_Private;
+
+	FScopeLock Lock(&Mutex);
+	return HottestSeconds;
+}
+
+void FForEachLoopStats::Reset()
+{
+	using namespace ForEachLoopStats_Private;
+
+	FScopeLock Lock(&Mutex);
+	NodeStats.Reset();
+	HottestSeconds = 0.0;
+}
@@ -0,0 +1,168 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "ForEachLoopTrace.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+TRACE_DECLARE_INT_COUNTER(ForEachMap_Iterations, TEXT("ForEachMap/Iterations"));
+TRACE_DECLARE_INT_COUNTER(ForEachMap_ElementsVisited, TEXT("ForEachMap/ElementsVisited"));
+TRACE_DECLARE_MEMORY_COUNTER(ForEachMap_SnapshotBytes, TEXT("ForEachMap/SnapshotBytes"));
+
+namespace ForEachLoopTrace
+{
+	bool GTraceEnabled = false;
+
+	static FAutoConsoleVariableRef CVarTrace(
+		TEXT("ForEachMap.Trace"),
+		GTraceEnabled,
+		TEXT("Emits a trace CPU scope per run of a map, set or array loop node, named after the Blueprint and the node GUID.\n")
+		TEXT("Along with counters of the iterations, elements visited and snapshot bytes of each run."),
+		ECVF_Default);
+
+	/** A Begin that never sees its End (Return out of a loop body) shouldn't grow the stack forever */
+	static constexpr int32 MaxOpenLoops = 64;
+
+	struct FOpenLoop
+	{
+		FName ScopeName;
+		int64 Iterations = 0;
+		int64 Visited = 0;
+		int64 SnapshotBytes = 0;
+		uint64 StartCycles = 0;
+
+		/** Iterator variable of the loop, claimed by its first step */
+		const void* Iterator = nullptr;
+
+		/** Whether we actually emitted a begin event, the CPU channel may have been off */
+		bool bEmittedScope = false;
+	};
+
+	/** Nested loops (and recursion) stack up, counts always go to the innermost one */
+	static thread_local TArray<FOpenLoop, TInlineAllocator<8>> OpenLoops;
+
+	/** Whether a step of the innermost loop's own iterator is running, nothing else gets to count */
+	static thread_local bool bCountingStep = false;
+
+	/** Only runs that reached their End count towards the stats, an abandoned one would just add the time until we noticed */
+	static void CloseInnermostLoop(bool bCompleted)
+	{
+		const FOpenLoop Loop = OpenLoops.Pop();
+
+		if (bCompleted && FForEachLoopStats::IsEnabled())
+		{
+			const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Loop.StartCycles);
+			FForEachLoopStats::Record(Loop.ScopeName, Loop.Iterations, Seconds);
+		}
+
+		if (GTraceEnabled)
+		{
+			TRACE_COUNTER_SET(ForEachMap_Iterations, Loop.Iterations);
+			TRACE_COUNTER_SET(ForEachMap_ElementsVisited, Loop.Visited);
+			TRACE_COUNTER_SET(ForEachMap_SnapshotBytes, Loop.SnapshotBytes);
+		}
+
+#if CPUPROFILERTRACE_ENABLED
+		if (Loop.bEmittedScope)
+		{
+			FCpuProfilerTrace::OutputEndEvent();
+		}
+#endif
+	}
+
+	void BeginLoop(FName ScopeName)
+	{
+		if (!IsEnabled())
+		{
+			return;
+		}
+
+		if (OpenLoops.Num() >= MaxOpenLoops)
+		{
+			CloseAbandonedLoops();
+		}
+
+		FOpenLoop& Loop = OpenLoops.AddDefaulted_GetRef();
+		Loop.ScopeName = ScopeName;
+		Loop.StartCycles = FPlatformTime::Cycles64();
+
+#if CPUPROFILERTRACE_ENABLED
+		if (GTraceEnabled && UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel))
+		{
+			FCpuProfilerTrace::OutputBeginDynamicEvent(ScopeName);
+			Loop.bEmittedScope = true;
+		}
+#endif
+	}
+
+	void EndLoop(FName ScopeName)
+	{
+		for (int32 Index = OpenLoops.Num() - 1; Index >= 0; --Index)
+		{
+			if (OpenLoops[Index].ScopeName == ScopeName)
+			{
+				// Anything above us got abandoned by a nested loop body returning early
+				while (OpenLoops.Num() > Index + 1)
+				{
+					CloseInnermostLoop(false);
+				}
+
+				CloseInnermostLoop(true);
+				return;
+			}
+		}
+	}
+
+	void CloseAbandonedLoops()
+	{
+		while (OpenLoops.Num() > 0)
+		{
+			CloseInnermostLoop(false);
+		}
+	}
+
+	bool BeginStep(const void* Iterator)
+	{
+		if (OpenLoops.Num() == 0)
+		{
+			return false;
+		}
+
+		// Begin is followed by the loop's own first step, before any of its body gets to run
+		FOpenLoop& Loop = OpenLoops.Last();
+		if (Loop.Iterator == nullptr)
+		{
+			Loop.Iterator = Iterator;
+		}
+
+		bCountingStep = Loop.Iterator == Iterator;
+		return bCountingStep;
+	}
+
+	void EndStep()
+	{
+		bCountingStep = false;
+	}
+
+	void AddCounts(int32 Iterations, int32 Visited, int64 SnapshotBytes)
+	{
+		if (bCountingStep && OpenLoops.Num() > 0)
+		{
+			FOpenLoop& Loop = OpenLoops.Last();
+			Loop.Iterations += Iterations;
+			Loop.Visited += Visited;
+			Loop.SnapshotBytes += SnapshotBytes;
+		}
+	}
+
+	/** Loops never legitimately span frames while traced (only immediate loops are), so whatever is still open on the game thread got abandoned */
+	static FDelayedAutoRegisterHelper GRegisterEndFrame(EDelayedRegisterRunPhase::EndOfEngineInit, []
+	{
+		FCoreDelegates::OnEndFrame.AddStatic(&CloseAbandonedLoops);
+	});
+}
@@ -0,0 +1,101 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "ForEachLoopStats.h"
+
+/**
+ * Insights instrumentation of the loop nodes, switched on through ForEachMap.Trace.
+ * Every loop run opens a CPU scope named after its Blueprint and node, and counts the entries it produced, the storage slots
+ * it looked at and the bytes it snapshotted while that scope is open. Switched off, counting is a single branch per call.
+ * ForEachMap.Stats keeps the same loop stack running, to hand completed runs to FForEachLoopStats.
+ */
+namespace ForEachLoopTrace
+{
+	extern bool GTraceEnabled;
+
+	FORCEINLINE bool IsEnabled()
+	{
+		return GTraceEnabled || FForEachLoopStats::IsEnabled();
+	}
+
+	/** Opens the scope of a loop run on this thread */
+	void BeginLoop(FName ScopeName);
+
+	/** Closes the innermost scope of that name on this thread and reports its counters. Also runs while switched off, to close what was opened before */
+	void EndLoop(FName ScopeName);
+
+	/** Closes whatever loops this thread left open, a Return out of a loop body never reaches the end of its loop */
+	void CloseAbandonedLoops();
+
+	/** Lets counts through to the innermost open loop if it belongs to Iterator, the first iterator to step within a loop claims it */
+	bool BeginStep(const void* Iterator);
+
+	/** Counts go nowhere again until the next step */
+	void EndStep();
+
+	/**
+	 * Scope of a single iterator step, identified by the address of its iterator variable.
+	 * Iterators without a loop scope of their own (cursors, time sliced and awaitable loops) step with a different
+	 * iterator than the traced loop whose body they run in, or without a scope at all, so their counts are dropped rather than added to that loop.
+	 */
+	struct FScopedStep
+	{
+		explicit FScopedStep(const void* Iterator)
+			: bCounting(IsEnabled() && BeginStep(Iterator))
+		{
+		}
+
+		~FScopedStep()
+		{
+			if (bCounting)
+			{
+				EndStep();
+			}
+		}
+
+	private:
+		bool bCounting;
+	};
+
+	/** Adds to the innermost open loop of this thread, if a step of its own iterator is running */
+	void AddCounts(int32 Iterations, int32 Visited, int64 SnapshotBytes);
+
+	/** The loop handed out another entry, after looking at Visited slots to find it */
+	FORCEINLINE void CountIteration(int32 Visited = 0)
+	{
+		if (IsEnabled())
+		{
+			AddCounts(1, Visited, 0);
+		}
+	}
+
+	/** The loop handed out a whole chunk of entries at once */
+	FORCEINLINE void CountIterations(int32 Iterations)
+	{
+		if (IsEnabled())
+		{
+			AddCounts(Iterations, 0, 0);
+		}
+	}
+
+	/** The loop looked at Visited slots of the storage */
+	FORCEINLINE void CountVisited(int32 Visited)
+	{
+		if (IsEnabled())
+		{
+			AddCounts(0, Visited, 0);
+		}
+	}
+
+	/** The loop copied what was left of its container into a snapshot */
+	FORCEINLINE void CountSnapshotBytes(int64 Bytes)
+	{
+		if (IsEnabled())
+		{
+			AddCounts(0, 0, Bytes);
+		}
+	}
+}
@@ -0,0 +1,1793 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "ForEachMapLibrary.h"
+
+#include "Async/ParallelFor.h"
+#include "ForEachLoopTrace.h"
+#include "Math/VectorRegister.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ForEachMapLibrary)
+
+#define LOCTEXT_NAMESPACE "ForEachMapLibrary"
+
+namespace ForEachMapLibrary_Private
+{
+	/** Finds the first allocated slot at or after the given sparse index and before EndIndex, INDEX_NONE if there is none. */
+	template <typename HelperType>
+	static int32 FindNextValidIndex(HelperType& Helper, int32 SparseIndex, int32 EndIndex = MAX_int32)
+	{
+		const int32 MaxIndex = FMath::Min(Helper.GetMaxIndex(), EndIndex);
+		const int32 FirstIndex = SparseIndex;
+		for (; SparseIndex < MaxIndex; ++SparseIndex)
+		{
+			if (Helper.IsValidIndex(SparseIndex))
+			{
+				ForEachLoopTrace::CountVisited(SparseIndex - FirstIndex + 1);
+				return SparseIndex;
+			}
+		}
+
+		ForEachLoopTrace::CountVisited(FMath::Max(MaxIndex - FirstIndex, 0));
+		return INDEX_NONE;
+	}
+
+	/** Finds the last allocated slot at or before the given sparse index, INDEX_NONE if there is none. */
+	template <typename HelperType>
+	static int32 FindPrevValidIndex(HelperType& Helper, int32 SparseIndex)
+	{
+		const int32 FirstIndex = FMath::Min(SparseIndex, Helper.GetMaxIndex() - 1);
+		for (SparseIndex = FirstIndex; SparseIndex >= 0; --SparseIndex)
+		{
+			if (Helper.IsValidIndex(SparseIndex))
+			{
+				ForEachLoopTrace::CountVisited(FirstIndex - SparseIndex + 1);
+				return SparseIndex;
+			}
+		}
+
+		ForEachLoopTrace::CountVisited(FMath::Max(FirstIndex + 1, 0));
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Where the next visit of a ranged walk lands in walk order, given the one we're at (INDEX_NONE before the first).
+	 * Returns INDEX_NONE once Count visits are done. Out of range inputs are clamped, a Stride below one walks every entry.
+	 */
+	static int32 NextRangedPosition(int32 Position, int32 Start, int32 Count, int32 Stride)
+	{
+		const int64 First = FMath::Max(Start, 0);
+		const int64 Step = FMath::Max(Stride, 1);
+		const int64 Next = Position == INDEX_NONE ? First : Position + Step;
+
+		if ((Count >= 0 && Next >= First + Count * Step) || Next >= MAX_int32)
+		{
+			return INDEX_NONE;
+		}
+
+		return static_cast<int32>(Next);
+	}
+
+	/** Shared by the map and set flavors of RangedIteratorNext, steps over as many allocated slots as the range asks for. */
+	template <typename HelperType>
+	static bool StepRangedIterator(HelperType& Helper, int32& SparseIndex, int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse)
+	{
+		if (SparseIndex == UForEachMapLibrary::IteratorEnd)
+		{
+			return false;
+		}
+
+		const int32 NextIndex = NextRangedPosition(Index, Start, Count, Stride);
+		if (NextIndex != INDEX_NONE)
+		{
+			// Before the first visit we stand in front of the first (or behind the last) slot
+			int32 Cursor = Index == INDEX_NONE ? (bReverse ? Helper.GetMaxIndex() : INDEX_NONE) : SparseIndex;
+			bool bFound = true;
+
+			for (int32 Skip = Index == INDEX_NONE ? NextIndex + 1 : NextIndex - Index; Skip > 0; --Skip)
+			{
+				Cursor = bReverse ? FindPrevValidIndex(Helper, Cursor - 1) : FindNextValidIndex(Helper, Cursor + 1);
+				if (Cursor == INDEX_NONE)
+				{
+					bFound = false;
+					break;
+				}
+			}
+
+			if (bFound)
+			{
+				SparseIndex = Cursor;
+				Index = NextIndex;
+				ForEachLoopTrace::CountIteration();
+				return true;
+			}
+		}
+
+		SparseIndex = UForEachMapLibrary::IteratorEnd;
+		return false;
+	}
+
+	/**
+	 * Shared by the map and set flavors of BatchNext, gathers the slots of the next chunk.
+	 * ChunkNum is the size of the chunk handed out before, Index moves past it onto the first entry of the new one, then it takes the new size.
+	 */
+	template <typename HelperType>
+	static bool StepBatch(HelperType& Helper, int32& SparseIndex, int32& Index, int32& ChunkNum, int32 BatchSize, TArray<int32, TInlineAllocator<64>>& OutSlots)
+	{
+		OutSlots.Reset();
+		if (SparseIndex == UForEachMapLibrary::IteratorEnd)
+		{
+			return false;
+		}
+
+		// No looking ahead past the chunk, the slots visited are counted by FindNextValidIndex and the next chunk starts right after ours
+		const int32 ChunkSize = FMath::Max(BatchSize, 1);
+		int32 Slot = SparseIndex;
+		while (OutSlots.Num() < ChunkSize && (Slot = FindNextValidIndex(Helper, Slot + 1)) != INDEX_NONE)
+		{
+			OutSlots.Add(Slot);
+		}
+
+		if (OutSlots.IsEmpty())
+		{
+			SparseIndex = UForEachMapLibrary::IteratorEnd;
+			return false;
+		}
+
+		SparseIndex = OutSlots.Last();
+		Index = Index == INDEX_NONE ? 0 : Index + ChunkNum;
+		ChunkNum = OutSlots.Num();
+		ForEachLoopTrace::CountIterations(OutSlots.Num());
+		return true;
+	}
+
+	/**
+	 * Shared by the map and set flavors of IteratorNext.
+	 * EndIndex is recorded on loop entry, slots the body appends past it are never visited. Null walks up to wherever the storage ends right now.
+	 */
+	template <typename HelperType>
+	static bool StepIterator(HelperType& Helper, int32& SparseIndex, int32& Index, int32* EndIndex = nullptr)
+	{
+		// Once we reached the end (or got broken out of) we stay there
+		if (SparseIndex == UForEachMapLibrary::IteratorEnd)
+		{
+			return false;
+		}
+
+		if (EndIndex != nullptr && Index == INDEX_NONE)
+		{
+			*EndIndex = Helper.GetMaxIndex();
+		}
+
+		SparseIndex = FindNextValidIndex(Helper, SparseIndex + 1, EndIndex != nullptr ? *EndIndex : MAX_int32);
+		if (SparseIndex == INDEX_NONE)
+		{
+			SparseIndex = UForEachMapLibrary::IteratorEnd;
+			return false;
+		}
+
+		++Index;
+		ForEachLoopTrace::CountIteration();
+		return true;
+	}
+
+	/**
+	 * Shared by the map and set flavors of SortedIteratorNext, walks the sorted sparse indices.
+	 * The loop body may have emptied slots ahead of us since they got sorted, those are passed over.
+	 */
+	template <typename HelperType>
+	static bool StepSortedIterator(HelperType& Helper, const TArray<int32>& SparseIndices, int32& SparseIndex, int32& Index)
+	{
+		if (SparseIndex == UForEachMapLibrary::IteratorEnd)
+		{
+			return false;
+		}
+
+		while (SparseIndices.IsValidIndex(++Index))
+		{
+			ForEachLoopTrace::CountVisited(1);
+			if (Helper.IsValidIndex(SparseIndices[Index]))
+			{
+				SparseIndex = SparseIndices[Index];
+				ForEachLoopTrace::CountIteration();
+				return true;
+			}
+		}
+
+		SparseIndex = UForEachMapLibrary::IteratorEnd;
+		return false;
+	}
+
+	/** Shared by the map and set flavors of SortedRangedIteratorNext, emptied slots use up their visit of the window. */
+	template <typename HelperType>
+	static bool StepSortedRangedIterator(HelperType& Helper, const TArray<int32>& SparseIndices, int32& SparseIndex, int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse)
+	{
+		if (SparseIndex == UForEachMapLibrary::IteratorEnd)
+		{
+			return false;
+		}
+
+		for (int32 NextIndex = NextRangedPosition(Index, Start, Count, Stride); NextIndex != INDEX_NONE && NextIndex < SparseIndices.Num(); NextIndex = NextRangedPosition(NextIndex, Start, Count, Stride))
+		{
+			ForEachLoopTrace::CountVisited(1);
+
+			const int32 Slot = SparseIndices[bReverse ? SparseIndices.Num() - 1 - NextIndex : NextIndex];
+			if (Helper.IsValidIndex(Slot))
+			{
+				SparseIndex = Slot;
+				Index = NextIndex;
+				ForEachLoopTrace::CountIteration();
+				return true;
+			}
+		}
+
+		SparseIndex = UForEachMapLibrary::IteratorEnd;
+		return false;
+	}
+
+	FORCEINLINE void EmptySnapshot(FScriptMapHelper& SnapshotHelper, int32 Slack)
+	{
+		SnapshotHelper.EmptyValues(Slack);
+	}
+
+	FORCEINLINE void EmptySnapshot(FScriptSetHelper& SnapshotHelper, int32 Slack)
+	{
+		SnapshotHelper.EmptyElements(Slack);
+	}
+
+	/** What a single snapshotted entry weighs, a map snapshot carries default values along with the keys */
+	FORCEINLINE int64 GetEntrySize(const FScriptMapHelper& Helper)
+	{
+		return Helper.GetKeyProperty()->GetSize() + Helper.GetValueProperty()->GetSize();
+	}
+
+	FORCEINLINE int64 GetEntrySize(const FScriptSetHelper& Helper)
+	{
+		return Helper.GetElementProperty()->GetSize();
+	}
+
+	/**
+	 * Shared by the map and set flavors of GuardedIteratorNext.
+	 * CopyEntry appends the entry at a live slot to the snapshot, FindLiveIndex resolves a snapshot slot back to the live one (INDEX_NONE once removed).
+	 */
+	template <typename HelperType, typename CopyEntryType, typename FindLiveIndexType>
+	static bool StepGuardedIterator(HelperType& Helper, HelperType& SnapshotHelper, FForEachMutationGuard& Guard, int32& SparseIndex, int32& Index, CopyEntryType CopyEntry, FindLiveIndexType FindLiveIndex)
+	{
+		if (SparseIndex == UForEachMapLibrary::IteratorEnd)
+		{
+			// Broken out of, let go of the copies just like at the natural end
+			if (Guard.bUsesSnapshot)
+			{
+				EmptySnapshot(SnapshotHelper, 0);
+				Guard.bUsesSnapshot = false;
+			}
+			return false;
+		}
+
+		// Loop entry, remember the layout we start out with
+		if (Index == INDEX_NONE)
+		{
+			Guard.ExpectedNum = Helper.Num();
+			Guard.ExpectedMaxIndex = Helper.GetMaxIndex();
+			Guard.bUsesSnapshot = false;
+			Guard.SnapshotIndex = INDEX_NONE;
+		}
+
+		// Only the count and the end of the storage tell us about changes, a removal paired with an add in the same step goes unnoticed
+		if (!Guard.bUsesSnapshot)
+		{
+			if (Helper.Num() == Guard.ExpectedNum && Helper.GetMaxIndex() == Guard.ExpectedMaxIndex)
+			{
+				return StepIterator(Helper, SparseIndex, Index);
+			}
+
+			// The body changed the container, hold on to what is left of the walk.
+			// Slots past the original end can only hold entries the body added, those are left out.
+			// An entry added into a slot freed ahead of us can't be told apart from the original ones and is copied along
+			const int32 EndIndex = FMath::Min(Helper.GetMaxIndex(), Guard.ExpectedMaxIndex);
+			EmptySnapshot(SnapshotHelper, FMath::Max(EndIndex - SparseIndex - 1, 0));
+			for (int32 Remaining = SparseIndex + 1; Remaining < EndIndex; ++Remaining)
+			{
+				if (Helper.IsValidIndex(Remaining))
+				{
+					CopyEntry(Remaining);
+				}
+			}
+			SnapshotHelper.Rehash();
+			ForEachLoopTrace::CountSnapshotBytes(SnapshotHelper.Num() * GetEntrySize(SnapshotHelper));
+
+			Guard.bUsesSnapshot = true;
+			Guard.SnapshotIndex = INDEX_NONE;
+		}
+
+		// Entries are looked up by value from here on, the live slots may move around as the body keeps changing things
+		while ((Guard.SnapshotIndex = FindNextValidIndex(SnapshotHelper, Guard.SnapshotIndex + 1)) != INDEX_NONE)
+		{
+			const int32 LiveIndex = FindLiveIndex(Guard.SnapshotIndex);
+			if (LiveIndex != INDEX_NONE)
+			{
+				SparseIndex = LiveIndex;
+				++Index;
+				ForEachLoopTrace::CountIteration();
+				return true;
+			}
+		}
+
+		// Done, don't keep the copies alive until the next run
+		EmptySnapshot(SnapshotHelper, 0);
+		Guard.bUsesSnapshot = false;
+		SparseIndex = UForEachMapLibrary::IteratorEnd;
+		return false;
+	}
+
+	/** Our own removals are expected, a mutation safe loop keeps walking the live storage after them */
+	FORCEINLINE void NotifyRemoved(FForEachMutationGuard& Guard)
+	{
+		if (!Guard.bUsesSnapshot)
+		{
+			--Guard.ExpectedNum;
+		}
+	}
+
+	/** Resolves and validates a function that gets called per entry, warns and returns null if it can't be used. */
+	static UFunction* FindEntryFunction(UObject* Object, FName FunctionName, TConstArrayView<const FProperty*> Arguments, bool bIsPredicate, bool bRequireThreadSafe)
+	{
+		UFunction* Function = Object ? Object->FindFunction(FunctionName) : nullptr;
+		if (!Function)
+		{
+			FFrame::KismetExecutionMessage(
+				*FText::Format(LOCTEXT("EntryFunctionNotFound", "Could not find function '{0}' on '{1}'."),
+					FText::FromName(FunctionName), FText::FromString(GetNameSafe(Object))).ToString(),
+				ELogVerbosity::Warning);
+			return nullptr;
+		}
+
+		// Thread safety is checked by the node when the Blueprint compiles, metadata only survives in editor builds
+#if WITH_METADATA
+		static const FName NAME_BlueprintThreadSafe(TEXT("BlueprintThreadSafe"));
+		const bool bIsThreadSafe = !bRequireThreadSafe || Function->HasMetaData(NAME_BlueprintThreadSafe);
+#else
+		const bool bIsThreadSafe = true;
+#endif
+
+		if (!bIsThreadSafe || !UForEachMapLibrary::IsEntryFunction(Function, Arguments, bIsPredicate))
+		{
+			FFrame::KismetExecutionMessage(
+				*FText::Format(LOCTEXT("EntryFunctionIncompatible", "Function '{0}' can't be called per entry, it has to take the container's entries as its only inputs."),
+					FText::FromName(FunctionName)).ToString(),
+				ELogVerbosity::Warning);
+			return nullptr;
+		}
+
+		return Function;
+	}
+
+	/** Parameter block of a function that gets called per entry, set up once and reused for every call. */
+	class FEntryFunctionCall
+	{
+	public:
+		FEntryFunctionCall(UObject* InObject, UFunction* InFunction)
+			: Object(InObject)
+			, Function(InFunction)
+			, Params(static_cast<uint8*>(FMemory::Malloc(FMath::Max(InFunction->ParmsSize, 1), InFunction->GetMinAlignment())))
+		{
+			FMemory::Memzero(Params, Function->ParmsSize);
+			for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+			{
+				It->InitializeValue_InContainer(Params);
+				if (!It->HasAnyPropertyFlags(CPF_ReturnParm))
+				{
+					Arguments.Add(*It);
+				}
+			}
+
+			ReturnProperty = CastField<FBoolProperty>(Function->GetReturnProperty());
+		}
+
+		~FEntryFunctionCall()
+		{
+			for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+			{
+				It->DestroyValue_InContainer(Params);
+			}
+
+			FMemory::Free(Params);
+		}
+
+		void SetArgument(int32 ArgumentIndex, const void* Value)
+		{
+			const FProperty* Argument = Arguments[ArgumentIndex];
+			Argument->CopyCompleteValue(Argument->ContainerPtrToValuePtr<void>(Params), Value);
+		}
+
+		/** Calls the function with the current arguments, returns what the predicate said (false if it isn't one) */
+		bool Call()
+		{
+			Object->ProcessEvent(Function, Params);
+			return ReturnProperty && ReturnProperty->GetPropertyValue_InContainer(Params);
+		}
+
+	private:
+		UObject* Object;
+		UFunction* Function;
+		uint8* Params;
+		TArray<const FProperty*, TInlineAllocator<2>> Arguments;
+		const FBoolProperty* ReturnProperty = nullptr;
+	};
+
+	/** Calls Function on Object for every item across worker threads, FillParams copies the item into the parameters. */
+	static void ParallelInvoke(UObject* Object, UFunction* Function, int32 NumItems, TFunctionRef<void(int32 Item, uint8* Params)> FillParams)
+	{
+		ParallelFor(NumItems, [Object, Function, &FillParams](int32 Item)
+		{
+			uint8* Params = static_cast<uint8*>(FMemory_Alloca_Aligned(Function->ParmsSize, Function->GetMinAlignment()));
+			FMemory::Memzero(Params, Function->ParmsSize);
+			for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+			{
+				It->InitializeValue_InContainer(Params);
+			}
+
+			FillParams(Item, Params);
+			Object->ProcessEvent(Function, Params);
+
+			for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+			{
+				It->DestroyValue_InContainer(Params);
+			}
+		});
+	}
+
+	/** Collects the allocated slots, so the work can be split into even ranges. */
+	template <typename HelperType>
+	static TArray<int32> GatherValidIndices(HelperType& Helper)
+	{
+		TArray<int32> Indices;
+		Indices.Reserve(Helper.Num());
+
+		const int32 MaxIndex = Helper.GetMaxIndex();
+		for (int32 SparseIndex = 0; SparseIndex < MaxIndex; ++SparseIndex)
+		{
+			if (Helper.IsValidIndex(SparseIndex))
+			{
+				Indices.Add(SparseIndex);
+			}
+		}
+
+		return Indices;
+	}
+
+	/** Calls Functor with a less-than for two values of the type behind Property, returns false if it can't be ordered. */
+	template <typename FunctorType>
+	static bool DispatchOrderable(const FProperty* Property, FunctorType&& Functor)
+	{
+		// Enums compare by their underlying number
+		if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			Property = EnumProperty->GetUnderlyingProperty();
+		}
+
+		if (Property->IsA<FIntProperty>())
+		{
+			Functor([](const void* A, const void* B) { return *static_cast<const int32*>(A) < *static_cast<const int32*>(B); });
+		}
+		else if (Property->IsA<FInt64Property>())
+		{
+			Functor([](const void* A, const void* B) { return *static_cast<const int64*>(A) < *static_cast<const int64*>(B); });
+		}
+		else if (Property->IsA<FByteProperty>())
+		{
+			Functor([](const void* A, const void* B) { return *static_cast<const uint8*>(A) < *static_cast<const uint8*>(B); });
+		}
+		else if (Property->IsA<FFloatProperty>())
+		{
+			Functor([](const void* A, const void* B) { return *static_cast<const float*>(A) < *static_cast<const float*>(B); });
+		}
+		else if (Property->IsA<FDoubleProperty>())
+		{
+			Functor([](const void* A, const void* B) { return *static_cast<const double*>(A) < *static_cast<const double*>(B); });
+		}
+		else if (Property->IsA<FStrProperty>())
+		{
+			Functor([](const void* A, const void* B) { return *static_cast<const FString*>(A) < *static_cast<const FString*>(B); });
+		}
+		else if (Property->IsA<FNameProperty>())
+		{
+			Functor([](const void* A, const void* B) { return static_cast<const FName*>(A)->Compare(*static_cast<const FName*>(B)) < 0; });
+		}
+		else if (Property->IsA<FTextProperty>())
+		{
+			Functor([](const void* A, const void* B) { return static_cast<const FText*>(A)->CompareTo(*static_cast<const FText*>(B)) < 0; });
+		}
+		else
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * Sorts the valid sparse indices of a container by the values GetValuePtr points them to.
+	 * Ties fall back to the sparse index, so the order is total and stays the same between runs.
+	 * A TopK below the number of entries keeps only the best TopK in a bounded heap, whose top is the worst one kept, then sorts just those.
+	 */
+	template <typename HelperType, typename GetValuePtrType>
+	static bool SortIndices(HelperType& Helper, const FProperty* SortProperty, bool bDescending, int32 TopK, GetValuePtrType GetValuePtr, TArray<int32>& OutSparseIndices)
+	{
+		return DispatchOrderable(SortProperty, [&](auto ValueLess)
+		{
+			auto Less = [&](int32 A, int32 B)
+			{
+				const void* ValueA = GetValuePtr(bDescending ? B : A);
+				const void* ValueB = GetValuePtr(bDescending ? A : B);
+				if (ValueLess(ValueA, ValueB))
+				{
+					return true;
+				}
+
+				return !ValueLess(ValueB, ValueA) && A < B;
+			};
+
+			const int32 Num = Helper.Num();
+			const int32 MaxIndex = Helper.GetMaxIndex();
+			OutSparseIndices.Reset();
+
+			if (TopK > 0 && TopK < Num)
+			{
+				auto WorstFirst = [&Less](int32 A, int32 B) { return Less(B, A); };
+
+				OutSparseIndices.Reserve(TopK);
+				for (int32 SparseIndex = 0; SparseIndex < MaxIndex; ++SparseIndex)
+				{
+					if (!Helper.IsValidIndex(SparseIndex))
+					{
+						continue;
+					}
+
+					if (OutSparseIndices.Num() < TopK)
+					{
+						OutSparseIndices.HeapPush(SparseIndex, WorstFirst);
+					}
+					else if (Less(SparseIndex, OutSparseIndices.HeapTop()))
+					{
+						OutSparseIndices.HeapPopDiscard(WorstFirst);
+						OutSparseIndices.HeapPush(SparseIndex, WorstFirst);
+					}
+				}
+			}
+			else
+			{
+				OutSparseIndices.Reserve(Num);
+				for (int32 SparseIndex = 0; SparseIndex < MaxIndex; ++SparseIndex)
+				{
+					if (Helper.IsValidIndex(SparseIndex))
+					{
+						OutSparseIndices.Add(SparseIndex);
+					}
+				}
+			}
+
+			OutSparseIndices.Sort(Less);
+		});
+	}
+
+	/** Running reduction over numbers that are fed in one at a time, for storage we can't load in lanes. Integers add up in int64, so they stay exact. */
+	template <typename AccumulatorType>
+	struct TAggregate
+	{
+		explicit TAggregate(EForEachAggregateOp InOperation)
+			: Operation(InOperation)
+		{
+		}
+
+		FORCEINLINE void Add(AccumulatorType Value)
+		{
+			if (Num++ == 0)
+			{
+				Result = Value;
+				return;
+			}
+
+			switch (Operation)
+			{
+			case EForEachAggregateOp::Min:
+				Result = FMath::Min(Result, Value);
+				break;
+			case EForEachAggregateOp::Max:
+				Result = FMath::Max(Result, Value);
+				break;
+			default:
+				Result += Value;
+				break;
+			}
+		}
+
+		/** Converted only once done, an integer average rounds toward zero */
+		template <typename ResultType>
+		ResultType Finish() const
+		{
+			return Operation == EForEachAggregateOp::Average && Num > 0 ? static_cast<ResultType>(Result) / Num : static_cast<ResultType>(Result);
+		}
+
+	private:
+		EForEachAggregateOp Operation;
+		AccumulatorType Result = 0;
+		int32 Num = 0;
+	};
+
+	/** Integers reduce in int64, anything else in double */
+	template <typename ValueType>
+	using TAccumulatorType = std::conditional_t<std::is_integral_v<ValueType>, int64, double>;
+
+	/** Calls Functor with a default constructed value of the C++ type behind Property, returns false if it isn't an integer. */
+	template <typename FunctorType>
+	static bool DispatchInteger(const FProperty* Property, FunctorType&& Functor)
+	{
+		if (Property->IsA<FIntProperty>())
+		{
+			Functor(int32());
+		}
+		else if (Property->IsA<FInt64Property>())
+		{
+			Functor(int64());
+		}
+		else if (Property->IsA<FByteProperty>())
+		{
+			Functor(uint8());
+		}
+		else
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	/** Same as DispatchInteger, but floats and doubles are fine too. */
+	template <typename FunctorType>
+	static bool DispatchNumeric(const FProperty* Property, FunctorType&& Functor)
+	{
+		if (DispatchInteger(Property, Functor))
+		{
+			return true;
+		}
+
+		if (Property->IsA<FFloatProperty>())
+		{
+			Functor(float());
+		}
+		else if (Property->IsA<FDoubleProperty>())
+		{
+			Functor(double());
+		}
+		else
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	/** Integer results only take integers, float results any number */
+	template <typename ResultType, typename FunctorType>
+	static bool DispatchAggregate(const FProperty* Property, FunctorType&& Functor)
+	{
+		if constexpr (std::is_integral_v<ResultType>)
+		{
+			return DispatchInteger(Property, Functor);
+		}
+		else
+		{
+			return DispatchNumeric(Property, Functor);
+		}
+	}
+
+	template <typename ResultType>
+	static void WarnNotAggregatable(const FProperty* ContainerProperty, const FProperty* ValueProperty)
+	{
+		const FText Message = std::is_integral_v<ResultType>
+			? LOCTEXT("AggregateNotInteger", "Can't aggregate '{0}' as integers, it holds {1}. Use the float version instead.")
+			: LOCTEXT("AggregateNotNumeric", "Can't aggregate '{0}', it holds {1} rather than numbers.");
+
+		FFrame::KismetExecutionMessage(
+			*FText::Format(Message, FText::FromName(ContainerProperty->GetFName()), FText::FromString(ValueProperty->GetCPPType())).ToString(),
+			ELogVerbosity::Warning);
+	}
+
+	/** Walks a sparse container, GetValuePtr returns null for the holes. */
+	template <typename ResultType, typename ValueType, typename GetValuePtrType>
+	static ResultType AggregateSparse(int32 MaxIndex, EForEachAggregateOp Operation, GetValuePtrType GetValuePtr)
+	{
+		TAggregate<TAccumulatorType<ValueType>> Aggregate(Operation);
+		for (int32 SparseIndex = 0; SparseIndex < MaxIndex; ++SparseIndex)
+		{
+			if (const uint8* ValuePtr = GetValuePtr(SparseIndex))
+			{
+				Aggregate.Add(*reinterpret_cast<const ValueType*>(ValuePtr));
+			}
+		}
+
+		return Aggregate.template Finish<ResultType>();
+	}
+
+	FORCEINLINE VectorRegister4Double LoadLanes(const double* Data)
+	{
+		return VectorLoad(Data);
+	}
+
+	FORCEINLINE VectorRegister4Double LoadLanes(const float* Data)
+	{
+		// Widened, so long sums of floats don't drift
+		return VectorRegister4Double(VectorLoad(Data));
+	}
+
+	/** Reduces four lanes at a time, then folds the lanes and the leftover tail. Needs at least four values. */
+	template <typename ValueType, typename VectorOpType, typename ScalarOpType>
+	static double ReduceLanes(const ValueType* Data, int32 Num, VectorOpType VectorOp, ScalarOpType ScalarOp)
+	{
+		VectorRegister4Double Accumulator = LoadLanes(Data);
+
+		int32 Index = 4;
+		for (; Index + 4 <= Num; Index += 4)
+		{
+			Accumulator = VectorOp(Accumulator, LoadLanes(Data + Index));
+		}
+
+		double Lanes[4];
+		VectorStore(Accumulator, Lanes);
+
+		double Result = ScalarOp(ScalarOp(Lanes[0], Lanes[1]), ScalarOp(Lanes[2], Lanes[3]));
+		for (; Index < Num; ++Index)
+		{
+			Result = ScalarOp(Result, static_cast<double>(Data[Index]));
+		}
+
+		return Result;
+	}
+
+	/** Contiguous storage, floats and doubles go through the vector kernels. */
+	template <typename ResultType, typename ValueType>
+	static ResultType AggregateContiguous(const ValueType* Data, int32 Num, EForEachAggregateOp Operation)
+	{
+		if constexpr (std::is_floating_point_v<ValueType>)
+		{
+			if (Num >= 4)
+			{
+				switch (Operation)
+				{
+				case EForEachAggregateOp::Min:
+					return ReduceLanes(Data, Num,
+						[](const VectorRegister4Double& A, const VectorRegister4Double& B) { return VectorMin(A, B); },
+						[](double A, double B) { return FMath::Min(A, B); });
+				case EForEachAggregateOp::Max:
+					return ReduceLanes(Data, Num,
+						[](const VectorRegister4Double& A, const VectorRegister4Double& B) { return VectorMax(A, B); },
+						[](double A, double B) { return FMath::Max(A, B); });
+				default:
+				{
+					const double Sum = ReduceLanes(Data, Num,
+						[](const VectorRegister4Double& A, const VectorRegister4Double& B) { return VectorAdd(A, B); },
+						[](double A, double B) { return A + B; });
+					return Operation == EForEachAggregateOp::Average ? Sum / Num : Sum;
+				}
+				}
+			}
+		}
+
+		TAggregate<TAccumulatorType<ValueType>> Aggregate(Operation);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Aggregate.Add(Data[Index]);
+		}
+
+		return Aggregate.template Finish<ResultType>();
+	}
+
+	template <typename ResultType>
+	static ResultType AggregateMapValues(const void* TargetMap, const FMapProperty* MapProperty, EForEachAggregateOp Operation)
+	{
+		if (!TargetMap)
+		{
+			return 0;
+		}
+
+		FScriptMapHelper MapHelper(MapProperty, TargetMap);
+		if (Operation == EForEachAggregateOp::Count)
+		{
+			return MapHelper.Num();
+		}
+
+		ResultType Result = 0;
+		const bool bIsAggregatable = DispatchAggregate<ResultType>(MapProperty->ValueProp, [&](auto Tag)
+		{
+			Result = AggregateSparse<ResultType, decltype(Tag)>(MapHelper.GetMaxIndex(), Operation, [&MapHelper](int32 SparseIndex) -> const uint8*
+			{
+				return MapHelper.IsValidIndex(SparseIndex) ? MapHelper.GetValuePtr(SparseIndex) : nullptr;
+			});
+		});
+
+		if (!bIsAggregatable)
+		{
+			WarnNotAggregatable<ResultType>(MapProperty, MapProperty->ValueProp);
+		}
+
+		return Result;
+	}
+
+	template <typename ResultType>
+	static ResultType AggregateSet(const void* TargetSet, const FSetProperty* SetProperty, EForEachAggregateOp Operation)
+	{
+		if (!TargetSet)
+		{
+			return 0;
+		}
+
+		FScriptSetHelper SetHelper(SetProperty, TargetSet);
+		if (Operation == EForEachAggregateOp::Count)
+		{
+			return SetHelper.Num();
+		}
+
+		ResultType Result = 0;
+		const bool bIsAggregatable = DispatchAggregate<ResultType>(SetProperty->ElementProp, [&](auto Tag)
+		{
+			Result = AggregateSparse<ResultType, decltype(Tag)>(SetHelper.GetMaxIndex(), Operation, [&SetHelper](int32 SparseIndex) -> const uint8*
+			{
+				return SetHelper.IsValidIndex(SparseIndex) ? SetHelper.GetElementPtr(SparseIndex) : nullptr;
+			});
+		});
+
+		if (!bIsAggregatable)
+		{
+			WarnNotAggregatable<ResultType>(SetProperty, SetProperty->ElementProp);
+		}
+
+		return Result;
+	}
+
+	template <typename ResultType>
+	static ResultType AggregateArray(const void* TargetArray, const FArrayProperty* ArrayProperty, EForEachAggregateOp Operation)
+	{
+		if (!TargetArray)
+		{
+			return 0;
+		}
+
+		FScriptArrayHelper ArrayHelper(ArrayProperty, TargetArray);
+		const int32 Num = ArrayHelper.Num();
+		if (Operation == EForEachAggregateOp::Count || Num == 0)
+		{
+			return Operation == EForEachAggregateOp::Count ? Num : 0;
+		}
+
+		ResultType Result = 0;
+		const bool bIsAggregatable = DispatchAggregate<ResultType>(ArrayProperty->Inner, [&](auto Tag)
+		{
+			Result = AggregateContiguous<ResultType>(reinterpret_cast<const decltype(Tag)*>(ArrayHelper.GetRawPtr(0)), Num, Operation);
+		});
+
+		if (!bIsAggregatable)
+		{
+			WarnNotAggregatable<ResultType>(ArrayProperty, ArrayProperty->Inner);
+		}
+
+		return Result;
+	}
+
+	/** Hash of what sits in the given slot, part of a cursor's fingerprint */
+	static uint32 GetSlotHash(FScriptMapHelper& Helper, int32 SparseIndex)
+	{
+		return Helper.GetKeyProperty()->GetValueTypeHash(Helper.GetKeyPtr(SparseIndex));
+	}
+
+	static uint32 GetSlotHash(FScriptSetHelper& Helper, int32 SparseIndex)
+	{
+		return Helper.GetElementProperty()->GetValueTypeHash(Helper.GetElementPtr(SparseIndex));
+	}
+
+	/** Points the cursor at the given slot, or finishes it if there is none */
+	template <typename HelperType>
+	static void MoveCursorTo(HelperType& Helper, FMapIterationCursor& Cursor, int32 SparseIndex)
+	{
+		if (SparseIndex == INDEX_NONE)
+		{
+			Cursor.SparseIndex = UForEachMapLibrary::IteratorEnd;
+			return;
+		}
+
+		Cursor.SparseIndex = SparseIndex;
+		Cursor.SlotHash = GetSlotHash(Helper, SparseIndex);
+	}
+
+	/** Shared by the map and set flavors of MakeCursor */
+	template <typename HelperType>
+	static FMapIterationCursor MakeCursor(HelperType& Helper)
+	{
+		FMapIterationCursor Cursor;
+		Cursor.ExpectedNum = Helper.Num();
+		Cursor.ExpectedMaxIndex = Helper.GetMaxIndex();
+		Cursor.Index = 0;
+		MoveCursorTo(Helper, Cursor, FindNextValidIndex(Helper, 0));
+		return Cursor;
+	}
+
+	/** Whether the container is laid out differently than when the cursor was made from it */
+	template <typename HelperType>
+	static bool IsCursorStale(HelperType& Helper, const FMapIterationCursor& Cursor)
+	{
+		if (Cursor.IsFinished())
+		{
+			return false;
+		}
+
+		return Helper.Num() != Cursor.ExpectedNum ||
+			Helper.GetMaxIndex() != Cursor.ExpectedMaxIndex ||
+			!Helper.IsValidIndex(Cursor.SparseIndex) ||
+			GetSlotHash(Helper, Cursor.SparseIndex) != Cursor.SlotHash;
+	}
+
+	/** Shared by the map and set flavors of AdvanceCursor */
+	template <typename HelperType>
+	static bool AdvanceCursor(HelperType& Helper, FMapIterationCursor& Cursor, int32 Steps, const FProperty* ContainerProperty)
+	{
+		if (IsCursorStale(Helper, Cursor))
+		{
+			FFrame::KismetExecutionMessage(
+				*FText::Format(LOCTEXT("CursorStale", "Can't advance the cursor, '{0}' was changed since the cursor was made from it."),
+					FText::FromName(ContainerProperty->GetFName())).ToString(),
+				ELogVerbosity::Warning);
+			Cursor.SparseIndex = UForEachMapLibrary::IteratorEnd;
+			return false;
+		}
+
+		for (; Steps > 0 && !Cursor.IsFinished(); --Steps)
+		{
+			MoveCursorTo(Helper, Cursor, FindNextValidIndex(Helper, Cursor.SparseIndex + 1));
+			++Cursor.Index;
+		}
+
+		return !Cursor.IsFinished();
+	}
+}
+
+bool UForEachMapLibrary::GenericMap_IteratorNext(const void* TargetMap, const FMapProperty* MapProperty, int32& SparseIndex, int32& Index, int32& EndIndex)
+{
+	// Counts only go to the traced loop this iterator belongs to
+	const ForEachLoopTrace::FScopedStep Step(&SparseIndex);
+
+	if (!TargetMap)
+	{
+		return false;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	return ForEachMapLibrary_Private::StepIterator(MapHelper, SparseIndex, Index, &EndIndex);
+}
+
+void UForEachMapLibrary::GenericMap_ParallelForEach(UObject* Object, FName FunctionName, const void* TargetMap, const FMapProperty* MapProperty)
+{
+	using namespace ForEachMapLibrary_Private;
+
+	if (!TargetMap)
+	{
+		return;
+	}
+
+	const FProperty* Arguments[] = { MapProperty->KeyProp, MapProperty->ValueProp };
+	UFunction* Function = FindEntryFunction(Object, FunctionName, Arguments, false, true);
+	if (!Function)
+	{
+		return;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	const TArray<int32> Indices = GatherValidIndices(MapHelper);
+
+	TArray<const FProperty*, TInlineAllocator<2>> Params;
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		Params.Add(*It);
+	}
+
+	ParallelInvoke(Object, Function, Indices.Num(), [&](int32 Item, uint8* ParamsBuffer)
+	{
+		Params[0]->CopyCompleteValue(Params[0]->ContainerPtrToValuePtr<void>(ParamsBuffer), MapHelper.GetKeyPtr(Indices[Item]));
+		Params[1]->CopyCompleteValue(Params[1]->ContainerPtrToValuePtr<void>(ParamsBuffer), MapHelper.GetValuePtr(Indices[Item]));
+	});
+}
+
+void UForEachMapLibrary::GenericMap_SortedIndices(const void* TargetMap, const FMapProperty* MapProperty, bool bByValue, bool bDescending, int32 TopK, TArray<int32>& OutSparseIndices)
+{
+	OutSparseIndices.Reset();
+	if (!TargetMap)
+	{
+		return;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	const FProperty* SortProperty = bByValue ? MapProperty->ValueProp : MapProperty->KeyProp;
+
+	const bool bIsOrderable = ForEachMapLibrary_Private::SortIndices(MapHelper, SortProperty, bDescending, TopK,
+		[&MapHelper, bByValue](int32 SparseIndex) -> const void*
+		{
+			return bByValue ? MapHelper.GetValuePtr(SparseIndex) : MapHelper.GetKeyPtr(SparseIndex);
+		},
+		OutSparseIndices);
+
+	if (!bIsOrderable)
+	{
+		FFrame::KismetExecutionMessage(
+			*FText::Format(LOCTEXT("MapNotOrderable", "Can't sort map '{0}' by {1}."),
+				FText::FromName(MapProperty->GetFName()), FText::FromString(SortProperty->GetCPPType())).ToString(),
+			ELogVerbosity::Warning);
+	}
+}
+
+bool UForEachMapLibrary::GenericMap_SortedIteratorNext(const void* TargetMap, const FMapProperty* MapProperty, const TArray<int32>& SparseIndices, int32& SparseIndex, int32& Index)
+{
+	const ForEachLoopTrace::FScopedStep Step(&SparseIndex);
+
+	if (!TargetMap)
+	{
+		return false;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	return ForEachMapLibrary_Private::StepSortedIterator(MapHelper, SparseIndices, SparseIndex, Index);
+}
+
+bool UForEachMapLibrary::GenericMap_SortedRangedIteratorNext(const void* TargetMap, const FMapProperty* MapProperty, const TArray<int32>& SparseIndices, int32& SparseIndex, int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse)
+{
+	const ForEachLoopTrace::FScopedStep Step(&SparseIndex);
+
+	if (!TargetMap)
+	{
+		return false;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	return ForEachMapLibrary_Private::StepSortedRangedIterator(MapHelper, SparseIndices, SparseIndex, Index, Start, Count, Stride, bReverse);
+}
+
+bool UForEachMapLibrary::GenericMap_GuardedIteratorNext(const void* TargetMap, const FMapProperty* MapProperty, FForEachMutationGuard& Guard, void* Snapshot, int32& SparseIndex, int32& Index)
+{
+	const ForEachLoopTrace::FScopedStep Step(&SparseIndex);
+
+	if (!TargetMap || !Snapshot)
+	{
+		return false;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	FScriptMapHelper SnapshotHelper(MapProperty, Snapshot);
+
+	return ForEachMapLibrary_Private::StepGuardedIterator(MapHelper, SnapshotHelper, Guard, SparseIndex, Index,
+		[&](int32 LiveIndex)
+		{
+			// Only the key is needed to find the pair again, the value stays default
+			const int32 NewIndex = SnapshotHelper.AddDefaultValue_Invalid_NeedsRehash();
+			MapProperty->KeyProp->CopySingleValue(SnapshotHelper.GetKeyPtr(NewIndex), MapHelper.GetKeyPtr(LiveIndex));
+		},
+		[&](int32 SnapshotIndex)
+		{
+			return MapHelper.FindMapIndexWithKey(SnapshotHelper.GetKeyPtr(SnapshotIndex));
+		});
+}
+
+bool UForEachMapLibrary::GenericMap_RangedIteratorNext(const void* TargetMap, const FMapProperty* MapProperty, int32& SparseIndex, int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse)
+{
+	const ForEachLoopTrace::FScopedStep Step(&SparseIndex);
+
+	if (!TargetMap)
+	{
+		return false;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	return ForEachMapLibrary_Private::StepRangedIterator(MapHelper, SparseIndex, Index, Start, Count, Stride, bReverse);
+}
+
+bool UForEachMapLibrary::GenericMap_BatchNext(const void* TargetMap, const FMapProperty* MapProperty, int32& SparseIndex, int32& Index, int32& ChunkNum, int32 BatchSize, void* Keys, const FArrayProperty* KeysProperty, void* Values, const FArrayProperty* ValuesProperty)
+{
+	const ForEachLoopTrace::FScopedStep Step(&SparseIndex);
+
+	if (!TargetMap || !Keys || !Values)
+	{
+		return false;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	FScriptArrayHelper KeysHelper(KeysProperty, Keys);
+	FScriptArrayHelper ValuesHelper(ValuesProperty, Values);
+
+	TArray<int32, TInlineAllocator<64>> Slots;
+	const bool bHasBatch = ForEachMapLibrary_Private::StepBatch(MapHelper, SparseIndex, Index, ChunkNum, BatchSize, Slots);
+
+	// Same size every chunk but the last, so the arrays keep their allocation
+	KeysHelper.Resize(Slots.Num());
+	ValuesHelper.Resize(Slots.Num());
+	for (int32 Item = 0; Item < Slots.Num(); ++Item)
+	{
+		MapProperty->KeyProp->CopySingleValue(KeysHelper.GetRawPtr(Item), MapHelper.GetKeyPtr(Slots[Item]));
+		MapProperty->ValueProp->CopySingleValue(ValuesHelper.GetRawPtr(Item), MapHelper.GetValuePtr(Slots[Item]));
+	}
+
+	return bHasBatch;
+}
+
+void UForEachMapLibrary::GenericMap_IteratorGetKey(const void* TargetMap, const FMapProperty* MapProperty, int32 SparseIndex, void* OutKey)
+{
+	if (!TargetMap)
+	{
+		return;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	if (!MapHelper.IsValidIndex(SparseIndex))
+	{
+		FFrame::KismetExecutionMessage(
+			*FText::Format(LOCTEXT("InvalidSparseIndex_GetKey", "Attempted to read the key at invalid sparse index {0} of map '{1}'."),
+				SparseIndex, FText::FromName(MapProperty->GetFName())).ToString(),
+			ELogVerbosity::Warning);
+		return;
+	}
+
+	MapProperty->KeyProp->CopySingleValueToScriptVM(OutKey, MapHelper.GetKeyPtr(SparseIndex));
+}
+
+void UForEachMapLibrary::GenericMap_IteratorGetValue(const void* TargetMap, const FMapProperty* MapProperty, int32 SparseIndex, void* OutValue)
+{
+	if (!TargetMap)
+	{
+		return;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	if (!MapHelper.IsValidIndex(SparseIndex))
+	{
+		FFrame::KismetExecutionMessage(
+			*FText::Format(LOCTEXT("InvalidSparseIndex_GetValue", "Attempted to read the value at invalid sparse index {0} of map '{1}'."),
+				SparseIndex, FText::FromName(MapProperty->GetFName())).ToString(),
+			ELogVerbosity::Warning);
+		return;
+	}
+
+	MapProperty->ValueProp->CopySingleValueToScriptVM(OutValue, MapHelper.GetValuePtr(SparseIndex));
+}
+
+void UForEachMapLibrary::GenericMap_IteratorGetPodKey(const void* TargetMap, const FMapProperty* MapProperty, int32 SparseIndex, void* OutKey)
+{
+	if (!TargetMap || !OutKey)
+	{
+		return;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	if (!MapHelper.IsValidIndex(SparseIndex) || !MapProperty->KeyProp->HasAnyPropertyFlags(CPF_IsPlainOldData))
+	{
+		// The generic path takes care of the warning, as well as of types that only looked like plain old data to the node
+		GenericMap_IteratorGetKey(TargetMap, MapProperty, SparseIndex, OutKey);
+		return;
+	}
+
+	FMemory::Memcpy(OutKey, MapHelper.GetKeyPtr(SparseIndex), MapProperty->KeyProp->GetSize());
+}
+
+void UForEachMapLibrary::GenericMap_IteratorGetPodValue(const void* TargetMap, const FMapProperty* MapProperty, int32 SparseIndex, void* OutValue)
+{
+	if (!TargetMap || !OutValue)
+	{
+		return;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	if (!MapHelper.IsValidIndex(SparseIndex) || !MapProperty->ValueProp->HasAnyPropertyFlags(CPF_IsPlainOldData))
+	{
+		GenericMap_IteratorGetValue(TargetMap, MapProperty, SparseIndex, OutValue);
+		return;
+	}
+
+	FMemory::Memcpy(OutValue, MapHelper.GetValuePtr(SparseIndex), MapProperty->ValueProp->GetSize());
+}
+
+void UForEachMapLibrary::GenericMap_IteratorSetValue(void* TargetMap, const FMapProperty* MapProperty, int32 SparseIndex, const void* Value)
+{
+	if (!TargetMap)
+	{
+		return;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	if (!MapHelper.IsValidIndex(SparseIndex))
+	{
+		FFrame::KismetExecutionMessage(
+			*FText::Format(LOCTEXT("InvalidSparseIndex_SetValue", "Attempted to write the value at invalid sparse index {0} of map '{1}'."),
+				SparseIndex, FText::FromName(MapProperty->GetFName())).ToString(),
+			ELogVerbosity::Warning);
+		return;
+	}
+
+	// Only the value changes, so the key hash and therefore the bucket stay valid
+	MapProperty->ValueProp->CopySingleValueFromScriptVM(MapHelper.GetValuePtr(SparseIndex), Value);
+}
+
+void UForEachMapLibrary::GenericMap_IteratorRemove(void* TargetMap, const FMapProperty* MapProperty, int32 SparseIndex, FForEachMutationGuard& Guard)
+{
+	if (!TargetMap)
+	{
+		return;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	if (!MapHelper.IsValidIndex(SparseIndex))
+	{
+		FFrame::KismetExecutionMessage(
+			*FText::Format(LOCTEXT("InvalidSparseIndex_Remove", "Attempted to remove the pair at invalid sparse index {0} of map '{1}'."),
+				SparseIndex, FText::FromName(MapProperty->GetFName())).ToString(),
+			ELogVerbosity::Warning);
+		return;
+	}
+
+	MapHelper.RemoveAt(SparseIndex);
+	ForEachMapLibrary_Private::NotifyRemoved(Guard);
+}
+
+bool UForEachMapLibrary::GenericSet_IteratorNext(const void* TargetSet, const FSetProperty* SetProperty, int32& SparseIndex, int32& Index, int32& EndIndex)
+{
+	const ForEachLoopTrace::FScopedStep Step(&SparseIndex);
+
+	if (!TargetSet)
+	{
+		return false;
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	return ForEachMapLibrary_Private::StepIterator(SetHelper, SparseIndex, Index, &EndIndex);
+}
+
+bool UForEachMapLibrary::GenericSet_GuardedIteratorNext(const void* TargetSet, const FSetProperty* SetProperty, FForEachMutationGuard& Guard, void* Snapshot, int32& SparseIndex, int32& Index)
+{
+	const ForEachLoopTrace::FScopedStep Step(&SparseIndex);
+
+	if (!TargetSet || !Snapshot)
+	{
+		return false;
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	FScriptSetHelper SnapshotHelper(SetProperty, Snapshot);
+
+	return ForEachMapLibrary_Private::StepGuardedIterator(SetHelper, SnapshotHelper, Guard, SparseIndex, Index,
+		[&](int32 LiveIndex)
+		{
+			const int32 NewIndex = SnapshotHelper.AddDefaultValue_Invalid_NeedsRehash();
+			SetProperty->ElementProp->CopySingleValue(SnapshotHelper.GetElementPtr(NewIndex), SetHelper.GetElementPtr(LiveIndex));
+		},
+		[&](int32 SnapshotIndex)
+		{
+			return SetHelper.FindElementIndex(SnapshotHelper.GetElementPtr(SnapshotIndex));
+		});
+}
+
+bool UForEachMapLibrary::GenericSet_RangedIteratorNext(const void* TargetSet, const FSetProperty* SetProperty, int32& SparseIndex, int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse)
+{
+	const ForEachLoopTrace::FScopedStep Step(&SparseIndex);
+
+	if (!TargetSet)
+	{
+		return false;
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	return ForEachMapLibrary_Private::StepRangedIterator(SetHelper, SparseIndex, Index, Start, Count, Stride, bReverse);
+}
+
+bool UForEachMapLibrary::GenericSet_BatchNext(const void* TargetSet, const FSetProperty* SetProperty, int32& SparseIndex, int32& Index, int32& ChunkNum, int32 BatchSize, void* Elements, const FArrayProperty* ElementsProperty)
+{
+	const ForEachLoopTrace::FScopedStep Step(&SparseIndex);
+
+	if (!TargetSet || !Elements)
+	{
+		return false;
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	FScriptArrayHelper ElementsHelper(ElementsProperty, Elements);
+
+	TArray<int32, TInlineAllocator<64>> Slots;
+	const bool bHasBatch = ForEachMapLibrary_Private::StepBatch(SetHelper, SparseIndex, Index, ChunkNum, BatchSize, Slots);
+
+	ElementsHelper.Resize(Slots.Num());
+	for (int32 Item = 0; Item < Slots.Num(); ++Item)
+	{
+		SetProperty->ElementProp->CopySingleValue(ElementsHelper.GetRawPtr(Item), SetHelper.GetElementPtr(Slots[Item]));
+	}
+
+	return bHasBatch;
+}
+
+void UForEachMapLibrary::GenericSet_IteratorGetElement(const void* TargetSet, const FSetProperty* SetProperty, int32 SparseIndex, void* OutElement)
+{
+	if (!TargetSet)
+	{
+		return;
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	if (!SetHelper.IsValidIndex(SparseIndex))
+	{
+		FFrame::KismetExecutionMessage(
+			*FText::Format(LOCTEXT("InvalidSparseIndex_GetElement", "Attempted to read the element at invalid sparse index {0} of set '{1}'."),
+				SparseIndex, FText::FromName(SetProperty->GetFName())).ToString(),
+			ELogVerbosity::Warning);
+		return;
+	}
+
+	SetProperty->ElementProp->CopySingleValueToScriptVM(OutElement, SetHelper.GetElementPtr(SparseIndex));
+}
+
+void UForEachMapLibrary::GenericSet_IteratorGetPodElement(const void* TargetSet, const FSetProperty* SetProperty, int32 SparseIndex, void* OutElement)
+{
+	if (!TargetSet || !OutElement)
+	{
+		return;
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	if (!SetHelper.IsValidIndex(SparseIndex) || !SetProperty->ElementProp->HasAnyPropertyFlags(CPF_IsPlainOldData))
+	{
+		GenericSet_IteratorGetElement(TargetSet, SetProperty, SparseIndex, OutElement);
+		return;
+	}
+
+	FMemory::Memcpy(OutElement, SetHelper.GetElementPtr(SparseIndex), SetProperty->ElementProp->GetSize());
+}
+
+void UForEachMapLibrary::GenericSet_IteratorRemove(void* TargetSet, const FSetProperty* SetProperty, int32 SparseIndex, FForEachMutationGuard& Guard)
+{
+	if (!TargetSet)
+	{
+		return;
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	if (!SetHelper.IsValidIndex(SparseIndex))
+	{
+		FFrame::KismetExecutionMessage(
+			*FText::Format(LOCTEXT("InvalidSparseIndex_RemoveElement", "Attempted to remove the element at invalid sparse index {0} of set '{1}'."),
+				SparseIndex, FText::FromName(SetProperty->GetFName())).ToString(),
+			ELogVerbosity::Warning);
+		return;
+	}
+
+	SetHelper.RemoveAt(SparseIndex);
+	ForEachMapLibrary_Private::NotifyRemoved(Guard);
+}
+
+void UForEachMapLibrary::GenericSet_SortedIndices(const void* TargetSet, const FSetProperty* SetProperty, bool bDescending, int32 TopK, TArray<int32>& OutSparseIndices)
+{
+	OutSparseIndices.Reset();
+	if (!TargetSet)
+	{
+		return;
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+
+	const bool bIsOrderable = ForEachMapLibrary_Private::SortIndices(SetHelper, SetProperty->ElementProp, bDescending, TopK,
+		[&SetHelper](int32 SparseIndex) -> const void*
+		{
+			return SetHelper.GetElementPtr(SparseIndex);
+		},
+		OutSparseIndices);
+
+	if (!bIsOrderable)
+	{
+		FFrame::KismetExecutionMessage(
+			*FText::Format(LOCTEXT("SetNotOrderable", "Can't sort set '{0}' of {1}."),
+				FText::FromName(SetProperty->GetFName()), FText::FromString(SetProperty->ElementProp->GetCPPType())).ToString(),
+			ELogVerbosity::Warning);
+	}
+}
+
+bool UForEachMapLibrary::GenericSet_SortedIteratorNext(const void* TargetSet, const FSetProperty* SetProperty, const TArray<int32>& SparseIndices, int32& SparseIndex, int32& Index)
+{
+	const ForEachLoopTrace::FScopedStep Step(&SparseIndex);
+
+	if (!TargetSet)
+	{
+		return false;
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	return ForEachMapLibrary_Private::StepSortedIterator(SetHelper, SparseIndices, SparseIndex, Index);
+}
+
+bool UForEachMapLibrary::GenericSet_SortedRangedIteratorNext(const void* TargetSet, const FSetProperty* SetProperty, const TArray<int32>& SparseIndices, int32& SparseIndex, int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse)
+{
+	const ForEachLoopTrace::FScopedStep Step(&SparseIndex);
+
+	if (!TargetSet)
+	{
+		return false;
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	return ForEachMapLibrary_Private::StepSortedRangedIterator(SetHelper, SparseIndices, SparseIndex, Index, Start, Count, Stride, bReverse);
+}
+
+void UForEachMapLibrary::GenericSet_ParallelForEach(UObject* Object, FName FunctionName, const void* TargetSet, const FSetProperty* SetProperty)
+{
+	using namespace ForEachMapLibrary_Private;
+
+	if (!TargetSet)
+	{
+		return;
+	}
+
+	const FProperty* Arguments[] = { SetProperty->ElementProp };
+	UFunction* Function = FindEntryFunction(Object, FunctionName, Arguments, false, true);
+	if (!Function)
+	{
+		return;
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	const TArray<int32> Indices = GatherValidIndices(SetHelper);
+
+	const FProperty* ElementParam = *TFieldIterator<FProperty>(Function);
+	ParallelInvoke(Object, Function, Indices.Num(), [&](int32 Item, uint8* ParamsBuffer)
+	{
+		ElementParam->CopyCompleteValue(ElementParam->ContainerPtrToValuePtr<void>(ParamsBuffer), SetHelper.GetElementPtr(Indices[Item]));
+	});
+}
+
+void UForEachMapLibrary::GenericMap_Filter(UObject* Object, FName FunctionName, const void* TargetMap, const FMapProperty* MapProperty, void* FilteredMap)
+{
+	using namespace ForEachMapLibrary_Private;
+
+	if (!TargetMap || !FilteredMap)
+	{
+		return;
+	}
+
+	const FProperty* Arguments[] = { MapProperty->KeyProp, MapProperty->ValueProp };
+	UFunction* Function = FindEntryFunction(Object, FunctionName, Arguments, true, false);
+	if (!Function)
+	{
+		return;
+	}
+
+	// Filtering a map into itself, build the result on the side
+	void* ScratchMap = nullptr;
+	if (TargetMap == FilteredMap)
+	{
+		ScratchMap = FMemory_Alloca(MapProperty->GetSize());
+		MapProperty->InitializeValue(ScratchMap);
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	FScriptMapHelper FilteredHelper(MapProperty, ScratchMap ? ScratchMap : FilteredMap);
+
+	// Presized for the worst case, where every pair passes
+	FilteredHelper.EmptyValues(MapHelper.Num());
+
+	FEntryFunctionCall Predicate(Object, Function);
+	for (int32 SparseIndex = 0, MaxIndex = MapHelper.GetMaxIndex(); SparseIndex < MaxIndex; ++SparseIndex)
+	{
+		if (!MapHelper.IsValidIndex(SparseIndex))
+		{
+			continue;
+		}
+
+		Predicate.SetArgument(0, MapHelper.GetKeyPtr(SparseIndex));
+		Predicate.SetArgument(1, MapHelper.GetValuePtr(SparseIndex));
+		if (Predicate.Call())
+		{
+			// Keys are unique already, so pairs are appended as is and hashed all at once below
+			const int32 NewIndex = FilteredHelper.AddDefaultValue_Invalid_NeedsRehash();
+			MapProperty->KeyProp->CopySingleValue(FilteredHelper.GetKeyPtr(NewIndex), MapHelper.GetKeyPtr(SparseIndex));
+			MapProperty->ValueProp->CopySingleValue(FilteredHelper.GetValuePtr(NewIndex), MapHelper.GetValuePtr(SparseIndex));
+		}
+	}
+
+	FilteredHelper.Rehash();
+
+	if (ScratchMap)
+	{
+		MapProperty->CopyCompleteValue(FilteredMap, ScratchMap);
+		MapProperty->DestroyValue(ScratchMap);
+	}
+}
+
+void UForEachMapLibrary::GenericSet_Filter(UObject* Object, FName FunctionName, const void* TargetSet, const FSetProperty* SetProperty, void* FilteredSet)
+{
+	using namespace ForEachMapLibrary_Private;
+
+	if (!TargetSet || !FilteredSet)
+	{
+		return;
+	}
+
+	const FProperty* Arguments[] = { SetProperty->ElementProp };
+	UFunction* Function = FindEntryFunction(Object, FunctionName, Arguments, true, false);
+	if (!Function)
+	{
+		return;
+	}
+
+	// Filtering a set into itself, build the result on the side
+	void* ScratchSet = nullptr;
+	if (TargetSet == FilteredSet)
+	{
+		ScratchSet = FMemory_Alloca(SetProperty->GetSize());
+		SetProperty->InitializeValue(ScratchSet);
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	FScriptSetHelper FilteredHelper(SetProperty, ScratchSet ? ScratchSet : FilteredSet);
+
+	// Presized for the worst case, where every element passes
+	FilteredHelper.EmptyElements(SetHelper.Num());
+
+	FEntryFunctionCall Predicate(Object, Function);
+	for (int32 SparseIndex = 0, MaxIndex = SetHelper.GetMaxIndex(); SparseIndex < MaxIndex; ++SparseIndex)
+	{
+		if (!SetHelper.IsValidIndex(SparseIndex))
+		{
+			continue;
+		}
+
+		Predicate.SetArgument(0, SetHelper.GetElementPtr(SparseIndex));
+		if (Predicate.Call())
+		{
+			// Elements are unique already, so they are appended as is and hashed all at once below
+			const int32 NewIndex = FilteredHelper.AddDefaultValue_Invalid_NeedsRehash();
+			SetProperty->ElementProp->CopySingleValue(FilteredHelper.GetElementPtr(NewIndex), SetHelper.GetElementPtr(SparseIndex));
+		}
+	}
+
+	FilteredHelper.Rehash();
+
+	if (ScratchSet)
+	{
+		SetProperty->CopyCompleteValue(FilteredSet, ScratchSet);
+		SetProperty->DestroyValue(ScratchSet);
+	}
+}
+
+double UForEachMapLibrary::GenericMap_AggregateValues(const void* TargetMap, const FMapProperty* MapProperty, EForEachAggregateOp Operation)
+{
+	return ForEachMapLibrary_Private::AggregateMapValues<double>(TargetMap, MapProperty, Operation);
+}
+
+int64 UForEachMapLibrary::GenericMap_AggregateValuesInt(const void* TargetMap, const FMapProperty* MapProperty, EForEachAggregateOp Operation)
+{
+	return ForEachMapLibrary_Private::AggregateMapValues<int64>(TargetMap, MapProperty, Operation);
+}
+
+double UForEachMapLibrary::GenericSet_Aggregate(const void* TargetSet, const FSetProperty* SetProperty, EForEachAggregateOp Operation)
+{
+	return ForEachMapLibrary_Private::AggregateSet<double>(TargetSet, SetProperty, Operation);
+}
+
+int64 UForEachMapLibrary::GenericSet_AggregateInt(const void* TargetSet, const FSetProperty* SetProperty, EForEachAggregateOp Operation)
+{
+	return ForEachMapLibrary_Private::AggregateSet<int64>(TargetSet, SetProperty, Operation);
+}
+
+double UForEachMapLibrary::GenericArray_Aggregate(const void* TargetArray, const FArrayProperty* ArrayProperty, EForEachAggregateOp Operation)
+{
+	return ForEachMapLibrary_Private::AggregateArray<double>(TargetArray, ArrayProperty, Operation);
+}
+
+int64 UForEachMapLibrary::GenericArray_AggregateInt(const void* TargetArray, const FArrayProperty* ArrayProperty, EForEachAggregateOp Operation)
+{
+	return ForEachMapLibrary_Private::AggregateArray<int64>(TargetArray, ArrayProperty, Operation);
+}
+
+bool UForEachMapLibrary::IsEntryFunction(const UFunction* Function, TConstArrayView<const FProperty*> Arguments, bool bIsPredicate)
+{
+	int32 NumParams = 0;
+	bool bReturnsBool = false;
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		if (It->HasAnyPropertyFlags(CPF_ReturnParm))
+		{
+			bReturnsBool = It->IsA<FBoolProperty>();
+			continue;
+		}
+
+		// Inputs only, references are fine since they point at our own copy
+		const bool bIsInput = !It->HasAnyPropertyFlags(CPF_OutParm) || It->HasAnyPropertyFlags(CPF_ReferenceParm);
+		if (!bIsInput || !Arguments.IsValidIndex(NumParams) || !It->SameType(Arguments[NumParams]))
+		{
+			return false;
+		}
+
+		++NumParams;
+	}
+
+	const bool bHasReturn = Function->GetReturnProperty() != nullptr;
+	return NumParams == Arguments.Num() && (bIsPredicate ? bReturnsBool : !bHasReturn);
+}
+
+bool UForEachMapLibrary::Array_IteratorNext(int32& Index, int32 Length)
+{
+	const ForEachLoopTrace::FScopedStep Step(&Index);
+
+	// Broken out of, don't count past the end
+	if (Index >= Length)
+	{
+		return false;
+	}
+
+	if (++Index < Length)
+	{
+		ForEachLoopTrace::CountIteration(1);
+		return true;
+	}
+
+	return false;
+}
+
+bool UForEachMapLibrary::Array_RangedIteratorNext(int32& Index, int32 Length, int32 Start, int32 Count, int32 Stride, bool bReverse)
+{
+	const ForEachLoopTrace::FScopedStep Step(&Index);
+
+	// Broken out of, or done already
+	if (Index >= Length)
+	{
+		return false;
+	}
+
+	// Back to walk order, that is what the range is about
+	const int32 Position = Index == INDEX_NONE ? INDEX_NONE : (bReverse ? Length - 1 - Index : Index);
+
+	const int32 NextPosition = ForEachMapLibrary_Private::NextRangedPosition(Position, Start, Count, Stride);
+	if (NextPosition == INDEX_NONE || NextPosition >= Length)
+	{
+		Index = Length;
+		return false;
+	}
+
+	Index = bReverse ? Length - 1 - NextPosition : NextPosition;
+	ForEachLoopTrace::CountIteration(1);
+	return true;
+}
+
+void UForEachMapLibrary::Trace_LoopBegin(FName ScopeName)
+{
+	ForEachLoopTrace::BeginLoop(ScopeName);
+}
+
+void UForEachMapLibrary::Trace_LoopEnd(FName ScopeName)
+{
+	ForEachLoopTrace::EndLoop(ScopeName);
+}
+
+bool UForEachMapLibrary::Cursor_IsFinished(const FMapIterationCursor& Cursor)
+{
+	return Cursor.IsFinished();
+}
+
+FMapIterationCursor UForEachMapLibrary::GenericMap_MakeCursor(const void* TargetMap, const FMapProperty* MapProperty)
+{
+	if (!TargetMap)
+	{
+		return FMapIterationCursor();
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	return ForEachMapLibrary_Private::MakeCursor(MapHelper);
+}
+
+bool UForEachMapLibrary::GenericMap_AdvanceCursor(const void* TargetMap, const FMapProperty* MapProperty, FMapIterationCursor& Cursor, int32 Steps)
+{
+	if (!TargetMap)
+	{
+		return false;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	return ForEachMapLibrary_Private::AdvanceCursor(MapHelper, Cursor, Steps, MapProperty);
+}
+
+bool UForEachMapLibrary::GenericMap_CursorGetPair(const void* TargetMap, const FMapProperty* MapProperty, const FMapIterationCursor& Cursor, void* OutKey, void* OutValue)
+{
+	if (!TargetMap)
+	{
+		return false;
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	if (Cursor.IsFinished() || ForEachMapLibrary_Private::IsCursorStale(MapHelper, Cursor))
+	{
+		return false;
+	}
+
+	MapProperty->KeyProp->CopySingleValueToScriptVM(OutKey, MapHelper.GetKeyPtr(Cursor.SparseIndex));
+	MapProperty->ValueProp->CopySingleValueToScriptVM(OutValue, MapHelper.GetValuePtr(Cursor.SparseIndex));
+	return true;
+}
+
+bool UForEachMapLibrary::GenericMap_IsCursorStale(const void* TargetMap, const FMapProperty* MapProperty, const FMapIterationCursor& Cursor)
+{
+	if (!TargetMap)
+	{
+		return !Cursor.IsFinished();
+	}
+
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	return ForEachMapLibrary_Private::IsCursorStale(MapHelper, Cursor);
+}
+
+FMapIterationCursor UForEachMapLibrary::GenericSet_MakeCursor(const void* TargetSet, const FSetProperty* SetProperty)
+{
+	if (!TargetSet)
+	{
+		return FMapIterationCursor();
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	return ForEachMapLibrary_Private::MakeCursor(SetHelper);
+}
+
+bool UForEachMapLibrary::GenericSet_AdvanceCursor(const void* TargetSet, const FSetProperty* SetProperty, FMapIterationCursor& Cursor, int32 Steps)
+{
+	if (!TargetSet)
+	{
+		return false;
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	return ForEachMapLibrary_Private::AdvanceCursor(SetHelper, Cursor, Steps, SetProperty);
+}
+
+bool UForEachMapLibrary::GenericSet_CursorGetElement(const void* TargetSet, const FSetProperty* SetProperty, const FMapIterationCursor& Cursor, void* OutElement)
+{
+	if (!TargetSet)
+	{
+		return false;
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	if (Cursor.IsFinished() || ForEachMapLibrary_Private::IsCursorStale(SetHelper, Cursor))
+	{
+		return false;
+	}
+
+	SetProperty->ElementProp->CopySingleValueToScriptVM(OutElement, SetHelper.GetElementPtr(Cursor.SparseIndex));
+	return true;
+}
+
+bool UForEachMapLibrary::GenericSet_IsCursorStale(const void* TargetSet, const FSetProperty* SetProperty, const FMapIterationCursor& Cursor)
+{
+	if (!TargetSet)
+	{
+		return !Cursor.IsFinished();
+	}
+
+	FScriptSetHelper SetHelper(SetProperty, TargetSet);
+	return ForEachMapLibrary_Private::IsCursorStale(SetHelper, Cursor);
+}
+
+void UForEachMapLibrary::TimeSlice_Begin(FForEachTimeSlice& TimeSlice)
+{
+	TimeSlice.StartCycles = FPlatformTime::Cycles64();
+	TimeSlice.Iterations = 0;
+}
+
+bool UForEachMapLibrary::TimeSlice_ShouldYield(FForEachTimeSlice& TimeSlice, double BudgetMs, int32 BudgetIterations)
+{
+	++TimeSlice.Iterations;
+
+	if (BudgetIterations > 0 && TimeSlice.Iterations >= BudgetIterations)
+	{
+		return true;
+	}
+
+	return BudgetMs > 0.0 && FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - TimeSlice.StartCycles) >= BudgetMs;
+}
+
+#undef LOCTEXT_NAMESPACE
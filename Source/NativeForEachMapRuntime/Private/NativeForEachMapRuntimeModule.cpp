@@ -0,0 +1,6 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+// Dummy module, only hosts the native functions the loop nodes expand into
+IMPLEMENT_MODULE(FDefaultModuleImpl, NativeForEachMapRuntime)
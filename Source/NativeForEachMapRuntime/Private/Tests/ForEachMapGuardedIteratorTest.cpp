@@ -0,0 +1,63 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "ForEachMapLibrary.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FForEachMapGuardedIteratorTest, "ForEachMap.GuardedIterator.SnapshotHandoff",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FForEachMapGuardedIteratorTest::RunTest(const FString& Parameters)
+{
+	// The map pin of the thunk is a TMap<int32, int32>, borrow its property rather than declaring one just for the test
+	const UFunction* Function = UForEachMapLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UForEachMapLibrary, Map_GuardedIteratorNext));
+	const FMapProperty* MapProperty = Function ? CastField<FMapProperty>(Function->FindPropertyByName(TEXT("TargetMap"))) : nullptr;
+	if (!TestNotNull(TEXT("Map property of Map_GuardedIteratorNext"), MapProperty))
+	{
+		return false;
+	}
+
+	TMap<int32, int32> Map;
+	for (int32 Key = 0; Key < 8; ++Key)
+	{
+		Map.Add(Key, Key * 10);
+	}
+
+	TMap<int32, int32> Snapshot;
+	FForEachMutationGuard Guard;
+	int32 SparseIndex = INDEX_NONE;
+	int32 Index = INDEX_NONE;
+
+	TArray<int32> Visited;
+	while (UForEachMapLibrary::GenericMap_GuardedIteratorNext(&Map, MapProperty, Guard, &Snapshot, SparseIndex, Index))
+	{
+		const int32 Key = *(const int32*)FScriptMapHelper(MapProperty, &Map).GetKeyPtr(SparseIndex);
+		Visited.Add(Key);
+
+		// The first two steps walk the live storage, the one after the body changed the map hands off to the snapshot
+		TestEqual(TEXT("Walks the snapshot"), Guard.bUsesSnapshot, Visited.Num() > 2);
+
+		if (Key == 1)
+		{
+			// Frees slot 3 ahead of the iterator, 100 refills it and 101 is appended past the end the storage had on entry
+			Map.Remove(3);
+			Map.Add(100, 1000);
+			Map.Add(101, 1010);
+		}
+	}
+
+	TestEqual(TEXT("Visited keys"), Visited, TArray<int32>({ 0, 1, 2, 100, 4, 5, 6, 7 }));
+	TestEqual(TEXT("Logical index after the last pair"), Index, Visited.Num() - 1);
+	TestEqual(TEXT("Iterator is parked at the end"), SparseIndex, UForEachMapLibrary::IteratorEnd);
+	TestFalse(TEXT("Snapshot is let go of once done"), Guard.bUsesSnapshot);
+	TestEqual(TEXT("Snapshot is emptied once done"), Snapshot.Num(), 0);
+
+	// Parked at the end, further steps don't start over
+	TestFalse(TEXT("Next after the end"), UForEachMapLibrary::GenericMap_GuardedIteratorNext(&Map, MapProperty, Guard, &Snapshot, SparseIndex, Index));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,47 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** What the runs of a single loop node added up to */
+struct FForEachLoopNodeStats
+{
+	int64 Invocations = 0;
+	int64 Iterations = 0;
+	double TotalSeconds = 0.0;
+
+	double GetAverageMs() const
+	{
+		return Invocations > 0 ? TotalSeconds * 1000.0 / Invocations : 0.0;
+	}
+};
+
+/**
+ * Per loop node counters the graph editor shows on the nodes, so hot loops can be spotted without a profiler.
+ * Runs are keyed by the name of their trace scope (Blueprint, node title and GUID), and only recorded while ForEachMap.Stats is on.
+ * Recording takes a lock per loop run, never per iteration. Counters start over whenever a game instance starts (e.g. PIE).
+ */
+class NATIVEFOREACHMAPRUNTIME_API FForEachLoopStats
+{
+public:
+	static bool IsEnabled()
+	{
+		return bEnabled;
+	}
+
+	/** Adds a completed run of the loop node */
+	static void Record(FName ScopeName, int64 Iterations, double Seconds);
+
+	/** Copies out the counters of a loop node, false if it hasn't run since the last reset */
+	static bool Find(FName ScopeName, FForEachLoopNodeStats& OutStats);
+
+	/** Total time of the loop node that took the most, the heat of every other node is relative to it */
+	static double GetHottestSeconds();
+
+	static void Reset();
+
+private:
+	/** Set through ForEachMap.Stats */
+	static bool bEnabled;
+};
@@ -0,0 +1,1410 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "ForEachMapLibrary.generated.h"
+
+/** How the aggregate functions reduce a container of numbers down to a single one */
+UENUM(BlueprintType)
+enum class EForEachAggregateOp : uint8
+{
+	Sum,
+	Min,
+	Max,
+	Average,
+	/** Number of entries, works for any type */
+	Count
+};
+
+/** Budget bookkeeping of a time-sliced loop, tracks how much of the current frame's slice it used up */
+USTRUCT(meta = (BlueprintInternalUseOnly = "true"))
+struct NATIVEFOREACHMAPRUNTIME_API FForEachTimeSlice
+{
+	GENERATED_BODY()
+
+	/** When the current slice started */
+	uint64 StartCycles = 0;
+
+	/** Iterations done within the current slice */
+	int32 Iterations = 0;
+};
+
+/** What a mutation safe loop knows about its container, so it notices the loop body changing it */
+USTRUCT(meta = (BlueprintInternalUseOnly = "true"))
+struct NATIVEFOREACHMAPRUNTIME_API FForEachMutationGuard
+{
+	GENERATED_BODY()
+
+	/** Layout of the container when the loop was entered */
+	int32 ExpectedNum = 0;
+	int32 ExpectedMaxIndex = 0;
+
+	/** Whether the body changed the container and the loop walks the snapshot since */
+	bool bUsesSnapshot = false;
+
+	/** Slot of the snapshot the loop is at */
+	int32 SnapshotIndex = INDEX_NONE;
+};
+
+/**
+ * Where a manual walk over a map or set stands, so it can be picked up again later on (next tick, another state, another actor).
+ * Remembers the layout of the container it was made from, and refuses to carry on once that changed.
+ */
+USTRUCT(BlueprintType)
+struct NATIVEFOREACHMAPRUNTIME_API FMapIterationCursor
+{
+	GENERATED_BODY()
+
+	/** Whether the cursor ran past the last entry, or never got made from a container */
+	bool IsFinished() const { return SparseIndex == MAX_int32; }
+
+	/** Slot of the entry the cursor is at, parked on UForEachMapLibrary::IteratorEnd once finished */
+	UPROPERTY()
+	int32 SparseIndex = MAX_int32;
+
+	/** Logical index of the entry the cursor is at */
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+
+	/** Layout of the container when the cursor was made */
+	UPROPERTY()
+	int32 ExpectedNum = 0;
+	UPROPERTY()
+	int32 ExpectedMaxIndex = 0;
+
+	/** Hash of the key at the current slot, catches the slot being freed and reused by another entry */
+	UPROPERTY()
+	uint32 SlotHash = 0;
+};
+
+/**
+ * Native functions the For Each Map and For Each Set nodes expand into.
+ * Walks the sparse storage of the container in place, so entering a loop costs nothing proportional to its size.
+ */
+UCLASS()
+class NATIVEFOREACHMAPRUNTIME_API UForEachMapLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Sparse index an iterator is parked on once it ran past the end, or got broken out of. Next never moves it away again */
+	static constexpr int32 IteratorEnd = MAX_int32;
+
+	/**
+	 * Moves the iterator onto the next pair of the map and counts the logical index up along with it.
+	 * Both indices start out at INDEX_NONE. Returns false once there are no more pairs.
+	 * Loop bookkeeping is a single call this way, rather than a validity check, an advance and an increment.
+	 * EndIndex gets the end of the storage on loop entry, pairs the body appends past it are never visited so the loop always ends.
+	 * A pair the body adds into a slot it freed ahead of the iterator is visited though, the storage reuses freed slots first.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap"))
+	static bool Map_IteratorNext(const TMap<int32, int32>& TargetMap, UPARAM(ref) int32& SparseIndex, UPARAM(ref) int32& Index, UPARAM(ref) int32& EndIndex);
+
+	/**
+	 * Same as Map_IteratorNext, but safe against the loop body adding or removing pairs.
+	 * Walks the live storage for as long as the map keeps its layout, which is a count check per step.
+	 * Once it changed, the keys still ahead of the iterator are copied into Snapshot and the rest of the walk looks them up in the live map,
+	 * skipping the ones that got removed. Pairs the body appends past the end the storage had on entry are never visited,
+	 * one it adds into a slot it freed ahead of the iterator is though, the storage reuses freed slots first.
+	 * Changes are only noticed through the count and the end of the storage. Removing a pair (other than through Map_IteratorRemove) and adding one
+	 * within the same step leaves both as they were, the added pair may then be visited if it lands in a slot ahead of the iterator.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap|Snapshot"))
+	static bool Map_GuardedIteratorNext(const TMap<int32, int32>& TargetMap, UPARAM(ref) FForEachMutationGuard& Guard, UPARAM(ref) TMap<int32, int32>& Snapshot, UPARAM(ref) int32& SparseIndex, UPARAM(ref) int32& Index);
+
+	/**
+	 * Same as Map_IteratorNext, but only visits a window of the map: from the Start-th pair on, every Stride-th one, Count times at most (a negative Count means no limit).
+	 * Reverse walks from the back. Index counts pairs in walk order, so it goes Start, Start + Stride, and so on. Skipped pairs never reach the VM.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap"))
+	static bool Map_RangedIteratorNext(const TMap<int32, int32>& TargetMap, UPARAM(ref) int32& SparseIndex, UPARAM(ref) int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse);
+
+	/**
+	 * Copies the next BatchSize pairs (or whatever is left) into Keys and Values, so a loop body can handle a whole chunk per VM dispatch.
+	 * Index is the logical index of the first pair of the chunk, SparseIndex the slot of its last one. Returns false once there are no more pairs.
+	 * ChunkNum remembers how many pairs the chunk handed out, the arrays belong to the loop body and may have been resized since.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap", ArrayParm = "Keys,Values"))
+	static bool Map_BatchNext(const TMap<int32, int32>& TargetMap, UPARAM(ref) int32& SparseIndex, UPARAM(ref) int32& Index, UPARAM(ref) int32& ChunkNum, int32 BatchSize, TArray<int32>& Keys, TArray<int32>& Values);
+
+	/** Copies out the key of the pair at the given sparse index. */
+	UFUNCTION(BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap", MapKeyParam = "Key"))
+	static void Map_IteratorGetKey(const TMap<int32, int32>& TargetMap, int32 SparseIndex, int32& Key);
+
+	/**
+	 * Same as Map_IteratorGetKey, for keys the node knows to be plain old data (numbers, names, enums, POD structs).
+	 * Copies the bytes straight into the output, without going through the key property.
+	 */
+	UFUNCTION(BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap", MapKeyParam = "Key"))
+	static void Map_IteratorGetPodKey(const TMap<int32, int32>& TargetMap, int32 SparseIndex, int32& Key);
+
+	/** Copies out the value of the pair at the given sparse index, no hashing involved. */
+	UFUNCTION(BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap", MapValueParam = "Value"))
+	static void Map_IteratorGetValue(const TMap<int32, int32>& TargetMap, int32 SparseIndex, int32& Value);
+
+	/** Same as Map_IteratorGetPodKey, but for values. */
+	UFUNCTION(BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap", MapValueParam = "Value"))
+	static void Map_IteratorGetPodValue(const TMap<int32, int32>& TargetMap, int32 SparseIndex, int32& Value);
+
+	/** Overwrites the value of the pair at the given sparse index in place, the map is not rehashed. */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap", MapValueParam = "Value"))
+	static void Map_IteratorSetValue(UPARAM(ref) TMap<int32, int32>& TargetMap, int32 SparseIndex, const int32& Value);
+
+	/**
+	 * Removes the pair at the given sparse index, which is O(1) and leaves every other slot where it is, so the walk carries on as usual.
+	 * Lets the guard of a mutation safe loop know the removal was ours, so it doesn't need to fall back to a snapshot.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap"))
+	static void Map_IteratorRemove(UPARAM(ref) TMap<int32, int32>& TargetMap, int32 SparseIndex, UPARAM(ref) FForEachMutationGuard& Guard);
+
+	/** Same as Map_IteratorNext, but for sets. */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", SetParam = "TargetSet"))
+	static bool Set_IteratorNext(const TSet<int32>& TargetSet, UPARAM(ref) int32& SparseIndex, UPARAM(ref) int32& Index, UPARAM(ref) int32& EndIndex);
+
+	/** Same as Map_GuardedIteratorNext, but for sets. */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", SetParam = "TargetSet|Snapshot"))
+	static bool Set_GuardedIteratorNext(const TSet<int32>& TargetSet, UPARAM(ref) FForEachMutationGuard& Guard, UPARAM(ref) TSet<int32>& Snapshot, UPARAM(ref) int32& SparseIndex, UPARAM(ref) int32& Index);
+
+	/** Same as Map_IteratorRemove, but for sets. */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", SetParam = "TargetSet"))
+	static void Set_IteratorRemove(UPARAM(ref) TSet<int32>& TargetSet, int32 SparseIndex, UPARAM(ref) FForEachMutationGuard& Guard);
+
+	/** Same as Map_RangedIteratorNext, but for sets. */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", SetParam = "TargetSet"))
+	static bool Set_RangedIteratorNext(const TSet<int32>& TargetSet, UPARAM(ref) int32& SparseIndex, UPARAM(ref) int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse);
+
+	/** Same as Map_BatchNext, but for sets. */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", SetParam = "TargetSet", ArrayParm = "Elements"))
+	static bool Set_BatchNext(const TSet<int32>& TargetSet, UPARAM(ref) int32& SparseIndex, UPARAM(ref) int32& Index, UPARAM(ref) int32& ChunkNum, int32 BatchSize, TArray<int32>& Elements);
+
+	/** Copies out the element at the given sparse index. */
+	UFUNCTION(BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", SetParam = "TargetSet|Element"))
+	static void Set_IteratorGetElement(const TSet<int32>& TargetSet, int32 SparseIndex, int32& Element);
+
+	/** Same as Map_IteratorGetPodKey, but for set elements. */
+	UFUNCTION(BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", SetParam = "TargetSet|Element"))
+	static void Set_IteratorGetPodElement(const TSet<int32>& TargetSet, int32 SparseIndex, int32& Element);
+
+	/** Starts a fresh slice, called on loop entry and whenever the loop resumed on a new frame. */
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static void TimeSlice_Begin(UPARAM(ref) FForEachTimeSlice& TimeSlice);
+
+	/**
+	 * Counts one iteration towards the current slice and returns true once the budget is used up, the loop waits for the next frame then.
+	 * A budget of zero or less is ignored, if both are the loop never yields.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static bool TimeSlice_ShouldYield(UPARAM(ref) FForEachTimeSlice& TimeSlice, double BudgetMs, int32 BudgetIterations);
+
+	/**
+	 * Opens a trace scope around a loop run and starts counting its iterations, only while ForEachMap.Trace is on.
+	 * ScopeName names the Blueprint and the loop node, it's what the run shows up as in Insights.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static void Trace_LoopBegin(FName ScopeName);
+
+	/** Closes the scope Trace_LoopBegin opened and reports the counters of the run, does nothing if it didn't open one. */
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static void Trace_LoopEnd(FName ScopeName);
+
+	/** Counts the array index up, starting at INDEX_NONE. Returns false once it reached the length, an index at or past it stays put. */
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static bool Array_IteratorNext(UPARAM(ref) int32& Index, int32 Length);
+
+	/**
+	 * Collects the sparse indices of the map sorted by key, or by value. Ties keep storage order.
+	 * With a TopK above zero only the first TopK of the order are collected, through a bounded heap in O(n log k) instead of a full sort.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap"))
+	static void Map_SortedIndices(const TMap<int32, int32>& TargetMap, bool bByValue, bool bDescending, int32 TopK, TArray<int32>& SparseIndices);
+
+	/** Same as Map_SortedIndices, but for sets. */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", SetParam = "TargetSet"))
+	static void Set_SortedIndices(const TSet<int32>& TargetSet, bool bDescending, int32 TopK, TArray<int32>& SparseIndices);
+
+	/**
+	 * Moves the iterator onto the next entry of a sorted walk, SparseIndex follows the sorted indices and Index counts along.
+	 * Both start out at INDEX_NONE, and IteratorEnd is never left again just like with Map_IteratorNext.
+	 * Slots the loop body emptied since sorting are skipped, Index is the position in the sorted order and skips along with them.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap"))
+	static bool Map_SortedIteratorNext(const TMap<int32, int32>& TargetMap, const TArray<int32>& SparseIndices, UPARAM(ref) int32& SparseIndex, UPARAM(ref) int32& Index);
+
+	/** Same as Map_SortedIteratorNext, but for sets. */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", SetParam = "TargetSet"))
+	static bool Set_SortedIteratorNext(const TSet<int32>& TargetSet, const TArray<int32>& SparseIndices, UPARAM(ref) int32& SparseIndex, UPARAM(ref) int32& Index);
+
+	/**
+	 * Same as Map_SortedIteratorNext, but only visits a window of the sorted entries. See Map_RangedIteratorNext.
+	 * Emptied slots still take up their place in the window, the visits after them stay where they were.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap"))
+	static bool Map_SortedRangedIteratorNext(const TMap<int32, int32>& TargetMap, const TArray<int32>& SparseIndices, UPARAM(ref) int32& SparseIndex, UPARAM(ref) int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse);
+
+	/** Same as Map_SortedRangedIteratorNext, but for sets. */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", SetParam = "TargetSet"))
+	static bool Set_SortedRangedIteratorNext(const TSet<int32>& TargetSet, const TArray<int32>& SparseIndices, UPARAM(ref) int32& SparseIndex, UPARAM(ref) int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse);
+
+	/**
+	 * Same as Array_IteratorNext, but only visits a window of the array. See Map_RangedIteratorNext.
+	 * Index is the actual array index here, parked on Length once the walk is over, just like a broken out of loop.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static bool Array_RangedIteratorNext(UPARAM(ref) int32& Index, int32 Length, int32 Start, int32 Count, int32 Stride, bool bReverse);
+
+	/**
+	 * Calls the named function of Object once per pair with (Key, Value), spread across worker threads.
+	 * The function has to be BlueprintThreadSafe. Returns once all pairs are done.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", DefaultToSelf = "Object", MapParam = "TargetMap"))
+	static void Map_ParallelForEach(UObject* Object, FName FunctionName, const TMap<int32, int32>& TargetMap);
+
+	/** Same as Map_ParallelForEach, but for sets. The function gets called with (Element). */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", DefaultToSelf = "Object", SetParam = "TargetSet"))
+	static void Set_ParallelForEach(UObject* Object, FName FunctionName, const TSet<int32>& TargetSet);
+
+	/**
+	 * Builds FilteredMap out of the pairs the named predicate of Object returns true for, called with (Key, Value).
+	 * The output is presized and hashed once at the end, rather than growing and rehashing per added pair.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", DefaultToSelf = "Object", MapParam = "TargetMap|FilteredMap"))
+	static void Map_Filter(UObject* Object, FName FunctionName, const TMap<int32, int32>& TargetMap, TMap<int32, int32>& FilteredMap);
+
+	/** Same as Map_Filter, but for sets. The predicate gets called with (Element). */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", DefaultToSelf = "Object", SetParam = "TargetSet|FilteredSet"))
+	static void Set_Filter(UObject* Object, FName FunctionName, const TSet<int32>& TargetSet, TSet<int32>& FilteredSet);
+
+	/**
+	 * Reduces the values of a map down to their sum, min, max, average or count, in one native pass.
+	 * Works on int, int64, byte, float and double values. Empty maps give 0.
+	 * Integers are reduced in int64 and only turned into a double at the end, past 2^53 that rounds, Map_AggregateValuesInt doesn't.
+	 */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "Utilities|Map", meta = (DisplayName = "Aggregate Map Values", MapParam = "TargetMap"))
+	static double Map_AggregateValues(const TMap<int32, int32>& TargetMap, EForEachAggregateOp Operation);
+
+	/** Same as Map_AggregateValues, but for int, int64 and byte values only, and exact. Averages round toward zero. */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "Utilities|Map", meta = (DisplayName = "Aggregate Map Values (Integer)", MapParam = "TargetMap"))
+	static int64 Map_AggregateValuesInt(const TMap<int32, int32>& TargetMap, EForEachAggregateOp Operation);
+
+	/** Same as Map_AggregateValues, but for the elements of a set. */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "Utilities|Set", meta = (DisplayName = "Aggregate Set", SetParam = "TargetSet"))
+	static double Set_Aggregate(const TSet<int32>& TargetSet, EForEachAggregateOp Operation);
+
+	/** Same as Map_AggregateValuesInt, but for the elements of a set. */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "Utilities|Set", meta = (DisplayName = "Aggregate Set (Integer)", SetParam = "TargetSet"))
+	static int64 Set_AggregateInt(const TSet<int32>& TargetSet, EForEachAggregateOp Operation);
+
+	/** Same as Map_AggregateValues, but for arrays. Float and double arrays are reduced four lanes at a time. */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "Utilities|Array", meta = (DisplayName = "Aggregate Array", ArrayParm = "TargetArray"))
+	static double Array_Aggregate(const TArray<int32>& TargetArray, EForEachAggregateOp Operation);
+
+	/** Same as Map_AggregateValuesInt, but for arrays. */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "Utilities|Array", meta = (DisplayName = "Aggregate Array (Integer)", ArrayParm = "TargetArray"))
+	static int64 Array_AggregateInt(const TArray<int32>& TargetArray, EForEachAggregateOp Operation);
+
+	/** Makes a cursor standing on the first pair of the map, finished right away if the map is empty. */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "Utilities|Map", meta = (DisplayName = "Make Map Cursor", MapParam = "TargetMap"))
+	static FMapIterationCursor Map_MakeCursor(const TMap<int32, int32>& TargetMap);
+
+	/**
+	 * Moves the cursor Steps pairs ahead. Returns false once it ran past the last pair.
+	 * A cursor whose map changed since it was made is finished with a warning instead.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Utilities|Map", meta = (DisplayName = "Advance Map Cursor", MapParam = "TargetMap"))
+	static bool Map_AdvanceCursor(const TMap<int32, int32>& TargetMap, UPARAM(ref) FMapIterationCursor& Cursor, int32 Steps = 1);
+
+	/** Copies out the pair the cursor is at. Returns false if the cursor is finished or its map changed since it was made. */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "Utilities|Map", meta = (DisplayName = "Get Map Cursor Pair", MapParam = "TargetMap", MapKeyParam = "Key", MapValueParam = "Value"))
+	static bool Map_CursorGetPair(const TMap<int32, int32>& TargetMap, const FMapIterationCursor& Cursor, int32& Key, int32& Value);
+
+	/** Whether the map got changed since the cursor was made from it. Finished cursors are never stale. */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "Utilities|Map", meta = (DisplayName = "Is Map Cursor Stale", MapParam = "TargetMap"))
+	static bool Map_IsCursorStale(const TMap<int32, int32>& TargetMap, const FMapIterationCursor& Cursor);
+
+	/** Same as Map_MakeCursor, but for sets. */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "Utilities|Set", meta = (DisplayName = "Make Set Cursor", SetParam = "TargetSet"))
+	static FMapIterationCursor Set_MakeCursor(const TSet<int32>& TargetSet);
+
+	/** Same as Map_AdvanceCursor, but for sets. */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Utilities|Set", meta = (DisplayName = "Advance Set Cursor", SetParam = "TargetSet"))
+	static bool Set_AdvanceCursor(const TSet<int32>& TargetSet, UPARAM(ref) FMapIterationCursor& Cursor, int32 Steps = 1);
+
+	/** Same as Map_CursorGetPair, but for sets. */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "Utilities|Set", meta = (DisplayName = "Get Set Cursor Element", SetParam = "TargetSet|Element"))
+	static bool Set_CursorGetElement(const TSet<int32>& TargetSet, const FMapIterationCursor& Cursor, int32& Element);
+
+	/** Same as Map_IsCursorStale, but for sets. */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "Utilities|Set", meta = (DisplayName = "Is Set Cursor Stale", SetParam = "TargetSet"))
+	static bool Set_IsCursorStale(const TSet<int32>& TargetSet, const FMapIterationCursor& Cursor);
+
+	/** Whether the cursor ran past the last entry of its container. */
+	UFUNCTION(BlueprintPure, Category = "Utilities|Map", meta = (DisplayName = "Is Cursor Finished"))
+	static bool Cursor_IsFinished(const FMapIterationCursor& Cursor);
+
+	DECLARE_FUNCTION(execMap_IteratorNext)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY_REF(FIntProperty, SparseIndex);
+		P_GET_PROPERTY_REF(FIntProperty, Index);
+		P_GET_PROPERTY_REF(FIntProperty, EndIndex);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericMap_IteratorNext(MapAddr, MapProperty, SparseIndex, Index, EndIndex);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_GuardedIteratorNext)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_STRUCT_REF(FForEachMutationGuard, Guard);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* SnapshotAddr = Stack.MostRecentPropertyAddress;
+
+		P_GET_PROPERTY_REF(FIntProperty, SparseIndex);
+		P_GET_PROPERTY_REF(FIntProperty, Index);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericMap_GuardedIteratorNext(MapAddr, MapProperty, Guard, SnapshotAddr, SparseIndex, Index);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_RangedIteratorNext)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY_REF(FIntProperty, SparseIndex);
+		P_GET_PROPERTY_REF(FIntProperty, Index);
+		P_GET_PROPERTY(FIntProperty, Start);
+		P_GET_PROPERTY(FIntProperty, Count);
+		P_GET_PROPERTY(FIntProperty, Stride);
+		P_GET_UBOOL(bReverse);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericMap_RangedIteratorNext(MapAddr, MapProperty, SparseIndex, Index, Start, Count, Stride, bReverse);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_BatchNext)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY_REF(FIntProperty, SparseIndex);
+		P_GET_PROPERTY_REF(FIntProperty, Index);
+		P_GET_PROPERTY_REF(FIntProperty, ChunkNum);
+		P_GET_PROPERTY(FIntProperty, BatchSize);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* KeysAddr = Stack.MostRecentPropertyAddress;
+		FArrayProperty* KeysProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ValuesAddr = Stack.MostRecentPropertyAddress;
+		FArrayProperty* ValuesProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		if (!KeysProperty || !ValuesProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericMap_BatchNext(MapAddr, MapProperty, SparseIndex, Index, ChunkNum, BatchSize, KeysAddr, KeysProperty, ValuesAddr, ValuesProperty);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_IteratorGetKey)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FIntProperty, SparseIndex);
+
+		// Since Key isn't really an int, step the stack manually
+		const FProperty* CurrKeyProp = MapProperty->KeyProp;
+		void* KeyStorageSpace = FMemory_Alloca(CurrKeyProp->GetSize());
+		CurrKeyProp->InitializeValue(KeyStorageSpace);
+
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.MostRecentPropertyContainer = nullptr;
+		Stack.StepCompiledIn<FProperty>(KeyStorageSpace);
+		void* KeyPtr = (Stack.MostRecentPropertyAddress != nullptr && Stack.MostRecentProperty->GetClass() == CurrKeyProp->GetClass()) ? Stack.MostRecentPropertyAddress : KeyStorageSpace;
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericMap_IteratorGetKey(MapAddr, MapProperty, SparseIndex, KeyPtr);
+		P_NATIVE_END;
+
+		CurrKeyProp->DestroyValue(KeyStorageSpace);
+	}
+
+	DECLARE_FUNCTION(execMap_IteratorGetValue)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FIntProperty, SparseIndex);
+
+		// Since Value isn't really an int, step the stack manually
+		const FProperty* CurrValueProp = MapProperty->ValueProp;
+		void* ValueStorageSpace = FMemory_Alloca(CurrValueProp->GetSize());
+		CurrValueProp->InitializeValue(ValueStorageSpace);
+
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.MostRecentPropertyContainer = nullptr;
+		Stack.StepCompiledIn<FProperty>(ValueStorageSpace);
+		void* ValuePtr = (Stack.MostRecentPropertyAddress != nullptr && Stack.MostRecentProperty->GetClass() == CurrValueProp->GetClass()) ? Stack.MostRecentPropertyAddress : ValueStorageSpace;
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericMap_IteratorGetValue(MapAddr, MapProperty, SparseIndex, ValuePtr);
+		P_NATIVE_END;
+
+		CurrValueProp->DestroyValue(ValueStorageSpace);
+	}
+
+	DECLARE_FUNCTION(execMap_IteratorGetPodKey)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FIntProperty, SparseIndex);
+
+		// Plain old data needs no constructed scratch value, the out param gets written in place
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.MostRecentPropertyContainer = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		void* KeyPtr = Stack.MostRecentPropertyAddress;
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericMap_IteratorGetPodKey(MapAddr, MapProperty, SparseIndex, KeyPtr);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_IteratorGetPodValue)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FIntProperty, SparseIndex);
+
+		// Plain old data needs no constructed scratch value, the out param gets written in place
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.MostRecentPropertyContainer = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		void* ValuePtr = Stack.MostRecentPropertyAddress;
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericMap_IteratorGetPodValue(MapAddr, MapProperty, SparseIndex, ValuePtr);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_IteratorSetValue)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FIntProperty, SparseIndex);
+
+		// Since Value isn't really an int, step the stack manually
+		const FProperty* CurrValueProp = MapProperty->ValueProp;
+		void* ValueStorageSpace = FMemory_Alloca(CurrValueProp->GetSize());
+		CurrValueProp->InitializeValue(ValueStorageSpace);
+
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.MostRecentPropertyContainer = nullptr;
+		Stack.StepCompiledIn<FProperty>(ValueStorageSpace);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericMap_IteratorSetValue(MapAddr, MapProperty, SparseIndex, ValueStorageSpace);
+		P_NATIVE_END;
+
+		CurrValueProp->DestroyValue(ValueStorageSpace);
+	}
+
+	DECLARE_FUNCTION(execMap_IteratorRemove)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FIntProperty, SparseIndex);
+		P_GET_STRUCT_REF(FForEachMutationGuard, Guard);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericMap_IteratorRemove(MapAddr, MapProperty, SparseIndex, Guard);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_IteratorNext)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY_REF(FIntProperty, SparseIndex);
+		P_GET_PROPERTY_REF(FIntProperty, Index);
+		P_GET_PROPERTY_REF(FIntProperty, EndIndex);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericSet_IteratorNext(SetAddr, SetProperty, SparseIndex, Index, EndIndex);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_GuardedIteratorNext)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_STRUCT_REF(FForEachMutationGuard, Guard);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SnapshotAddr = Stack.MostRecentPropertyAddress;
+
+		P_GET_PROPERTY_REF(FIntProperty, SparseIndex);
+		P_GET_PROPERTY_REF(FIntProperty, Index);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericSet_GuardedIteratorNext(SetAddr, SetProperty, Guard, SnapshotAddr, SparseIndex, Index);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_IteratorRemove)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FIntProperty, SparseIndex);
+		P_GET_STRUCT_REF(FForEachMutationGuard, Guard);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericSet_IteratorRemove(SetAddr, SetProperty, SparseIndex, Guard);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_RangedIteratorNext)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY_REF(FIntProperty, SparseIndex);
+		P_GET_PROPERTY_REF(FIntProperty, Index);
+		P_GET_PROPERTY(FIntProperty, Start);
+		P_GET_PROPERTY(FIntProperty, Count);
+		P_GET_PROPERTY(FIntProperty, Stride);
+		P_GET_UBOOL(bReverse);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericSet_RangedIteratorNext(SetAddr, SetProperty, SparseIndex, Index, Start, Count, Stride, bReverse);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_BatchNext)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY_REF(FIntProperty, SparseIndex);
+		P_GET_PROPERTY_REF(FIntProperty, Index);
+		P_GET_PROPERTY_REF(FIntProperty, ChunkNum);
+		P_GET_PROPERTY(FIntProperty, BatchSize);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ElementsAddr = Stack.MostRecentPropertyAddress;
+		FArrayProperty* ElementsProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ElementsProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericSet_BatchNext(SetAddr, SetProperty, SparseIndex, Index, ChunkNum, BatchSize, ElementsAddr, ElementsProperty);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_IteratorGetElement)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FIntProperty, SparseIndex);
+
+		// Since Element isn't really an int, step the stack manually
+		const FProperty* CurrElementProp = SetProperty->ElementProp;
+		void* ElementStorageSpace = FMemory_Alloca(CurrElementProp->GetSize());
+		CurrElementProp->InitializeValue(ElementStorageSpace);
+
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.MostRecentPropertyContainer = nullptr;
+		Stack.StepCompiledIn<FProperty>(ElementStorageSpace);
+		void* ElementPtr = (Stack.MostRecentPropertyAddress != nullptr && Stack.MostRecentProperty->GetClass() == CurrElementProp->GetClass()) ? Stack.MostRecentPropertyAddress : ElementStorageSpace;
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericSet_IteratorGetElement(SetAddr, SetProperty, SparseIndex, ElementPtr);
+		P_NATIVE_END;
+
+		CurrElementProp->DestroyValue(ElementStorageSpace);
+	}
+
+	DECLARE_FUNCTION(execSet_IteratorGetPodElement)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FIntProperty, SparseIndex);
+
+		// Plain old data needs no constructed scratch value, the out param gets written in place
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.MostRecentPropertyContainer = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		void* ElementPtr = Stack.MostRecentPropertyAddress;
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericSet_IteratorGetPodElement(SetAddr, SetProperty, SparseIndex, ElementPtr);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_SortedIndices)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_UBOOL(bByValue);
+		P_GET_UBOOL(bDescending);
+		P_GET_PROPERTY(FIntProperty, TopK);
+		P_GET_TARRAY_REF(int32, SparseIndices);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericMap_SortedIndices(MapAddr, MapProperty, bByValue, bDescending, TopK, SparseIndices);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_SortedIteratorNext)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_TARRAY_REF(int32, SparseIndices);
+		P_GET_PROPERTY_REF(FIntProperty, SparseIndex);
+		P_GET_PROPERTY_REF(FIntProperty, Index);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericMap_SortedIteratorNext(MapAddr, MapProperty, SparseIndices, SparseIndex, Index);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_SortedRangedIteratorNext)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_TARRAY_REF(int32, SparseIndices);
+		P_GET_PROPERTY_REF(FIntProperty, SparseIndex);
+		P_GET_PROPERTY_REF(FIntProperty, Index);
+		P_GET_PROPERTY(FIntProperty, Start);
+		P_GET_PROPERTY(FIntProperty, Count);
+		P_GET_PROPERTY(FIntProperty, Stride);
+		P_GET_UBOOL(bReverse);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericMap_SortedRangedIteratorNext(MapAddr, MapProperty, SparseIndices, SparseIndex, Index, Start, Count, Stride, bReverse);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_SortedIndices)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_UBOOL(bDescending);
+		P_GET_PROPERTY(FIntProperty, TopK);
+		P_GET_TARRAY_REF(int32, SparseIndices);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericSet_SortedIndices(SetAddr, SetProperty, bDescending, TopK, SparseIndices);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_SortedIteratorNext)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_TARRAY_REF(int32, SparseIndices);
+		P_GET_PROPERTY_REF(FIntProperty, SparseIndex);
+		P_GET_PROPERTY_REF(FIntProperty, Index);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericSet_SortedIteratorNext(SetAddr, SetProperty, SparseIndices, SparseIndex, Index);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_SortedRangedIteratorNext)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_TARRAY_REF(int32, SparseIndices);
+		P_GET_PROPERTY_REF(FIntProperty, SparseIndex);
+		P_GET_PROPERTY_REF(FIntProperty, Index);
+		P_GET_PROPERTY(FIntProperty, Start);
+		P_GET_PROPERTY(FIntProperty, Count);
+		P_GET_PROPERTY(FIntProperty, Stride);
+		P_GET_UBOOL(bReverse);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericSet_SortedRangedIteratorNext(SetAddr, SetProperty, SparseIndices, SparseIndex, Index, Start, Count, Stride, bReverse);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_ParallelForEach)
+	{
+		P_GET_OBJECT(UObject, Object);
+		P_GET_PROPERTY(FNameProperty, FunctionName);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericMap_ParallelForEach(Object, FunctionName, MapAddr, MapProperty);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_ParallelForEach)
+	{
+		P_GET_OBJECT(UObject, Object);
+		P_GET_PROPERTY(FNameProperty, FunctionName);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericSet_ParallelForEach(Object, FunctionName, SetAddr, SetProperty);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_Filter)
+	{
+		P_GET_OBJECT(UObject, Object);
+		P_GET_PROPERTY(FNameProperty, FunctionName);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* FilteredMapAddr = Stack.MostRecentPropertyAddress;
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericMap_Filter(Object, FunctionName, MapAddr, MapProperty, FilteredMapAddr);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_Filter)
+	{
+		P_GET_OBJECT(UObject, Object);
+		P_GET_PROPERTY(FNameProperty, FunctionName);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* FilteredSetAddr = Stack.MostRecentPropertyAddress;
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericSet_Filter(Object, FunctionName, SetAddr, SetProperty, FilteredSetAddr);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_AggregateValues)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_ENUM(EForEachAggregateOp, Operation);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(double*)RESULT_PARAM = GenericMap_AggregateValues(MapAddr, MapProperty, Operation);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_AggregateValuesInt)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_ENUM(EForEachAggregateOp, Operation);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(int64*)RESULT_PARAM = GenericMap_AggregateValuesInt(MapAddr, MapProperty, Operation);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_Aggregate)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_ENUM(EForEachAggregateOp, Operation);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(double*)RESULT_PARAM = GenericSet_Aggregate(SetAddr, SetProperty, Operation);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_AggregateInt)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_ENUM(EForEachAggregateOp, Operation);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(int64*)RESULT_PARAM = GenericSet_AggregateInt(SetAddr, SetProperty, Operation);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execArray_Aggregate)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+		FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_ENUM(EForEachAggregateOp, Operation);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(double*)RESULT_PARAM = GenericArray_Aggregate(ArrayAddr, ArrayProperty, Operation);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execArray_AggregateInt)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+		FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_ENUM(EForEachAggregateOp, Operation);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(int64*)RESULT_PARAM = GenericArray_AggregateInt(ArrayAddr, ArrayProperty, Operation);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_MakeCursor)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(FMapIterationCursor*)RESULT_PARAM = GenericMap_MakeCursor(MapAddr, MapProperty);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_AdvanceCursor)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_STRUCT_REF(FMapIterationCursor, Cursor);
+		P_GET_PROPERTY(FIntProperty, Steps);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericMap_AdvanceCursor(MapAddr, MapProperty, Cursor, Steps);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMap_CursorGetPair)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_STRUCT_REF(FMapIterationCursor, Cursor);
+
+		// Since Key and Value aren't really ints, step the stack manually
+		const FProperty* CurrKeyProp = MapProperty->KeyProp;
+		void* KeyStorageSpace = FMemory_Alloca(CurrKeyProp->GetSize());
+		CurrKeyProp->InitializeValue(KeyStorageSpace);
+
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.MostRecentPropertyContainer = nullptr;
+		Stack.StepCompiledIn<FProperty>(KeyStorageSpace);
+		void* KeyPtr = (Stack.MostRecentPropertyAddress != nullptr && Stack.MostRecentProperty->GetClass() == CurrKeyProp->GetClass()) ? Stack.MostRecentPropertyAddress : KeyStorageSpace;
+
+		const FProperty* CurrValueProp = MapProperty->ValueProp;
+		void* ValueStorageSpace = FMemory_Alloca(CurrValueProp->GetSize());
+		CurrValueProp->InitializeValue(ValueStorageSpace);
+
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.MostRecentPropertyContainer = nullptr;
+		Stack.StepCompiledIn<FProperty>(ValueStorageSpace);
+		void* ValuePtr = (Stack.MostRecentPropertyAddress != nullptr && Stack.MostRecentProperty->GetClass() == CurrValueProp->GetClass()) ? Stack.MostRecentPropertyAddress : ValueStorageSpace;
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericMap_CursorGetPair(MapAddr, MapProperty, Cursor, KeyPtr, ValuePtr);
+		P_NATIVE_END;
+
+		CurrValueProp->DestroyValue(ValueStorageSpace);
+		CurrKeyProp->DestroyValue(KeyStorageSpace);
+	}
+
+	DECLARE_FUNCTION(execMap_IsCursorStale)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_STRUCT_REF(FMapIterationCursor, Cursor);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericMap_IsCursorStale(MapAddr, MapProperty, Cursor);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_MakeCursor)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(FMapIterationCursor*)RESULT_PARAM = GenericSet_MakeCursor(SetAddr, SetProperty);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_AdvanceCursor)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_STRUCT_REF(FMapIterationCursor, Cursor);
+		P_GET_PROPERTY(FIntProperty, Steps);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericSet_AdvanceCursor(SetAddr, SetProperty, Cursor, Steps);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSet_CursorGetElement)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_STRUCT_REF(FMapIterationCursor, Cursor);
+
+		// Since Element isn't really an int, step the stack manually
+		const FProperty* CurrElementProp = SetProperty->ElementProp;
+		void* ElementStorageSpace = FMemory_Alloca(CurrElementProp->GetSize());
+		CurrElementProp->InitializeValue(ElementStorageSpace);
+
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.MostRecentPropertyContainer = nullptr;
+		Stack.StepCompiledIn<FProperty>(ElementStorageSpace);
+		void* ElementPtr = (Stack.MostRecentPropertyAddress != nullptr && Stack.MostRecentProperty->GetClass() == CurrElementProp->GetClass()) ? Stack.MostRecentPropertyAddress : ElementStorageSpace;
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericSet_CursorGetElement(SetAddr, SetProperty, Cursor, ElementPtr);
+		P_NATIVE_END;
+
+		CurrElementProp->DestroyValue(ElementStorageSpace);
+	}
+
+	DECLARE_FUNCTION(execSet_IsCursorStale)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FSetProperty>(nullptr);
+		void* SetAddr = Stack.MostRecentPropertyAddress;
+		FSetProperty* SetProperty = CastField<FSetProperty>(Stack.MostRecentProperty);
+		if (!SetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_STRUCT_REF(FMapIterationCursor, Cursor);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericSet_IsCursorStale(SetAddr, SetProperty, Cursor);
+		P_NATIVE_END;
+	}
+
+	static bool GenericMap_IteratorNext(const void* TargetMap, const FMapProperty* MapProperty, int32& SparseIndex, int32& Index, int32& EndIndex);
+	static bool GenericMap_GuardedIteratorNext(const void* TargetMap, const FMapProperty* MapProperty, FForEachMutationGuard& Guard, void* Snapshot, int32& SparseIndex, int32& Index);
+	static bool GenericMap_RangedIteratorNext(const void* TargetMap, const FMapProperty* MapProperty, int32& SparseIndex, int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse);
+	static bool GenericMap_BatchNext(const void* TargetMap, const FMapProperty* MapProperty, int32& SparseIndex, int32& Index, int32& ChunkNum, int32 BatchSize, void* Keys, const FArrayProperty* KeysProperty, void* Values, const FArrayProperty* ValuesProperty);
+	static void GenericMap_IteratorGetKey(const void* TargetMap, const FMapProperty* MapProperty, int32 SparseIndex, void* OutKey);
+	static void GenericMap_IteratorGetValue(const void* TargetMap, const FMapProperty* MapProperty, int32 SparseIndex, void* OutValue);
+	static void GenericMap_IteratorGetPodKey(const void* TargetMap, const FMapProperty* MapProperty, int32 SparseIndex, void* OutKey);
+	static void GenericMap_IteratorGetPodValue(const void* TargetMap, const FMapProperty* MapProperty, int32 SparseIndex, void* OutValue);
+	static void GenericMap_IteratorSetValue(void* TargetMap, const FMapProperty* MapProperty, int32 SparseIndex, const void* Value);
+
+	static void GenericMap_IteratorRemove(void* TargetMap, const FMapProperty* MapProperty, int32 SparseIndex, FForEachMutationGuard& Guard);
+	static void GenericMap_SortedIndices(const void* TargetMap, const FMapProperty* MapProperty, bool bByValue, bool bDescending, int32 TopK, TArray<int32>& OutSparseIndices);
+	static bool GenericMap_SortedIteratorNext(const void* TargetMap, const FMapProperty* MapProperty, const TArray<int32>& SparseIndices, int32& SparseIndex, int32& Index);
+	static bool GenericMap_SortedRangedIteratorNext(const void* TargetMap, const FMapProperty* MapProperty, const TArray<int32>& SparseIndices, int32& SparseIndex, int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse);
+	static void GenericMap_ParallelForEach(UObject* Object, FName FunctionName, const void* TargetMap, const FMapProperty* MapProperty);
+
+	static bool GenericSet_IteratorNext(const void* TargetSet, const FSetProperty* SetProperty, int32& SparseIndex, int32& Index, int32& EndIndex);
+	static bool GenericSet_GuardedIteratorNext(const void* TargetSet, const FSetProperty* SetProperty, FForEachMutationGuard& Guard, void* Snapshot, int32& SparseIndex, int32& Index);
+	static bool GenericSet_RangedIteratorNext(const void* TargetSet, const FSetProperty* SetProperty, int32& SparseIndex, int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse);
+	static bool GenericSet_BatchNext(const void* TargetSet, const FSetProperty* SetProperty, int32& SparseIndex, int32& Index, int32& ChunkNum, int32 BatchSize, void* Elements, const FArrayProperty* ElementsProperty);
+	static void GenericSet_IteratorGetElement(const void* TargetSet, const FSetProperty* SetProperty, int32 SparseIndex, void* OutElement);
+	static void GenericSet_IteratorGetPodElement(const void* TargetSet, const FSetProperty* SetProperty, int32 SparseIndex, void* OutElement);
+	static void GenericSet_IteratorRemove(void* TargetSet, const FSetProperty* SetProperty, int32 SparseIndex, FForEachMutationGuard& Guard);
+	static void GenericSet_SortedIndices(const void* TargetSet, const FSetProperty* SetProperty, bool bDescending, int32 TopK, TArray<int32>& OutSparseIndices);
+	static bool GenericSet_SortedIteratorNext(const void* TargetSet, const FSetProperty* SetProperty, const TArray<int32>& SparseIndices, int32& SparseIndex, int32& Index);
+	static bool GenericSet_SortedRangedIteratorNext(const void* TargetSet, const FSetProperty* SetProperty, const TArray<int32>& SparseIndices, int32& SparseIndex, int32& Index, int32 Start, int32 Count, int32 Stride, bool bReverse);
+	static void GenericSet_ParallelForEach(UObject* Object, FName FunctionName, const void* TargetSet, const FSetProperty* SetProperty);
+
+	static void GenericMap_Filter(UObject* Object, FName FunctionName, const void* TargetMap, const FMapProperty* MapProperty, void* FilteredMap);
+	static void GenericSet_Filter(UObject* Object, FName FunctionName, const void* TargetSet, const FSetProperty* SetProperty, void* FilteredSet);
+
+	static FMapIterationCursor GenericMap_MakeCursor(const void* TargetMap, const FMapProperty* MapProperty);
+	static bool GenericMap_AdvanceCursor(const void* TargetMap, const FMapProperty* MapProperty, FMapIterationCursor& Cursor, int32 Steps);
+	static bool GenericMap_CursorGetPair(const void* TargetMap, const FMapProperty* MapProperty, const FMapIterationCursor& Cursor, void* OutKey, void* OutValue);
+	static bool GenericMap_IsCursorStale(const void* TargetMap, const FMapProperty* MapProperty, const FMapIterationCursor& Cursor);
+	static FMapIterationCursor GenericSet_MakeCursor(const void* TargetSet, const FSetProperty* SetProperty);
+	static bool GenericSet_AdvanceCursor(const void* TargetSet, const FSetProperty* SetProperty, FMapIterationCursor& Cursor, int32 Steps);
+	static bool GenericSet_CursorGetElement(const void* TargetSet, const FSetProperty* SetProperty, const FMapIterationCursor& Cursor, void* OutElement);
+	static bool GenericSet_IsCursorStale(const void* TargetSet, const FSetProperty* SetProperty, const FMapIterationCursor& Cursor);
+
+	static double GenericMap_AggregateValues(const void* TargetMap, const FMapProperty* MapProperty, EForEachAggregateOp Operation);
+	static int64 GenericMap_AggregateValuesInt(const void* TargetMap, const FMapProperty* MapProperty, EForEachAggregateOp Operation);
+	static double GenericSet_Aggregate(const void* TargetSet, const FSetProperty* SetProperty, EForEachAggregateOp Operation);
+	static int64 GenericSet_AggregateInt(const void* TargetSet, const FSetProperty* SetProperty, EForEachAggregateOp Operation);
+	static double GenericArray_Aggregate(const void* TargetArray, const FArrayProperty* ArrayProperty, EForEachAggregateOp Operation);
+	static int64 GenericArray_AggregateInt(const void* TargetArray, const FArrayProperty* ArrayProperty, EForEachAggregateOp Operation);
+
+	/**
+	 * Whether Function can be called with exactly the given arguments, by value or by reference.
+	 * Predicates have to return a bool, anything else must not return anything.
+	 */
+	static bool IsEntryFunction(const UFunction* Function, TConstArrayView<const FProperty*> Arguments, bool bIsPredicate);
+};